@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <sdsl/bit_vectors.hpp>
+
+using namespace std;
+using namespace sdsl;
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+#ifndef BV_TYPE
+#define BV_TYPE sdsl::pef_vector<>
+#endif
+
+//! Answers the queries rands[i&mask] for i in [0..times) and returns the sum of the results
+template<class t_support>
+uint64_t test_queries(const t_support& s, const int_vector<64>& rands, uint64_t mask, uint64_t times)
+{
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<times; ++i) {
+        cnt += s(rands[i&mask]);
+    }
+    return cnt;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " bit_vector_file" << endl;
+        cout << " builds a " << BV_ID << " for the bitvector stored in bit_vector_file" << endl;
+        cout << " and measures its space and the time of rank and select queries" << endl;
+        return 1;
+    }
+    typedef BV_TYPE bv_type;
+    bit_vector bv;
+    if (!load_from_file(bv, argv[1])) {
+        cerr << "Could not load " << argv[1] << endl;
+        return 1;
+    }
+    cout << "# BV_ID = " << BV_ID << endl;
+    cout << "# plain_size = " << size_in_mega_bytes(bv) << endl;
+    auto start = timer::now();
+    bv_type v(bv);
+    typename bv_type::rank_1_type rank1(&v);
+    typename bv_type::select_1_type select1(&v);
+    typename bv_type::select_0_type select0(&v);
+    auto stop = timer::now();
+    util::clear(bv);
+    cout << "# construct_time = " << duration_cast<milliseconds>(stop-start).count() << endl;
+    cout << "# size = " << size_in_mega_bytes(v) + size_in_mega_bytes(rank1)
+         + size_in_mega_bytes(select1) + size_in_mega_bytes(select0) << endl;
+    const uint64_t reps = 10000000;
+    const uint64_t ones = rank1(v.size());
+    uint64_t mask = 0;
+    int_vector<64> rands = util::rnd_positions<int_vector<64>>(20, mask, v.size()+1, 17);
+    start = timer::now();
+    uint64_t check = test_queries(rank1, rands, mask, reps);
+    stop = timer::now();
+    cout << "# rank_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+    cout << "# rank_check = " << check << endl;
+    rands = util::rnd_positions<int_vector<64>>(20, mask, ones, 17);
+    for (uint64_t i=0; i<rands.size(); ++i) rands[i] = rands[i]+1;
+    start = timer::now();
+    check = test_queries(select1, rands, mask, reps);
+    stop = timer::now();
+    cout << "# select_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+    cout << "# select_check = " << check << endl;
+    rands = util::rnd_positions<int_vector<64>>(20, mask, v.size()-ones, 17);
+    for (uint64_t i=0; i<rands.size(); ++i) rands[i] = rands[i]+1;
+    start = timer::now();
+    check = test_queries(select0, rands, mask, reps);
+    stop = timer::now();
+    cout << "# select0_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+    cout << "# select0_check = " << check << endl;
+}
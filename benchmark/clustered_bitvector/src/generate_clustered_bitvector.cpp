@@ -0,0 +1,54 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <sdsl/int_vector.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " length file" << endl;
+        cout << " generates a bit_vector of `length` bits, which consists of" << endl;
+        cout << " regions of zeros, ones, sparse ones, sparse zeros and short" << endl;
+        cout << " runs, and saves it to `file`." << endl;
+        cout << "`length` format:\n";
+        cout << "  X, where X is the length in number of bytes\n";
+        cout << "  XkB, where X is the length in number of kilobytes\n";
+        cout << "  XMB, where X is the length in number of megabytes\n";
+        cout << "  XGB, where X is the length in number of gigabytes\n";
+        return 1;
+    }
+    uint64_t length = atoll(argv[1])*8; // length in bits
+    string length_str(argv[1]);
+    size_t Bpos = length_str.find_first_of("B");
+    if (Bpos != string::npos and Bpos > 1) {
+        char order = length_str.substr(Bpos-1,1)[0];
+        if (order == 'k' or order == 'K')
+            length <<= 10;
+        else if (order == 'm' or order == 'M')
+            length <<= 20;
+        else if (order == 'g' or order == 'G')
+            length <<= 30;
+    }
+    bit_vector v(length, 0);
+    std::mt19937_64 rng(17);
+    for (uint64_t i=0; i < v.size();) {
+        uint64_t kind = rng() % 5;
+        uint64_t len = 1 + rng() % (1ULL<<16);
+        uint64_t run = 1 + rng() % 32;
+        for (uint64_t j=i; j < std::min(i+len, v.size()); ++j) {
+            switch (kind) {
+                case 0: v[j] = 0; break;                     // zeros
+                case 1: v[j] = 1; break;                     // ones
+                case 2: v[j] = (rng() % 64) == 0; break;     // sparse ones
+                case 3: v[j] = (rng() % 64) != 0; break;     // sparse zeros
+                default: v[j] = ((j / run) & 1);             // short runs
+            }
+        }
+        i += len;
+    }
+    if (!store_to_file(v, argv[2]))
+        return 1;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <sdsl/suffix_arrays.hpp>
+
+using namespace std;
+using namespace sdsl;
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+#ifndef CSA_TYPE
+#define CSA_TYPE sdsl::csa_wt<>
+#endif
+
+//! Backward search with two independent rank calls per step.
+template<class t_csa, class t_pat_iter>
+uint64_t count_two_ranks(const t_csa& csa, t_pat_iter begin, t_pat_iter end)
+{
+    uint64_t l = 0, r = csa.size()-1;
+    while (begin < end and r+1-l > 0) {
+        auto c = *(--end);
+        uint64_t c_begin = csa.C[csa.char2comp[c]];
+        l = c_begin + csa.bwt.rank(l, c);
+        r = c_begin + csa.bwt.rank(r+1, c) - 1;
+    }
+    return r+1-l;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " text_file tmp_dir" << endl;
+        cout << " builds a " << CSA_ID << " for the text and measures the throughput of count" << endl;
+        cout << " with two rank calls and with one rank_pair call per backward search step," << endl;
+        cout << " and of count_batch, which searches the patterns in lock-step" << endl;
+        return 1;
+    }
+    typedef CSA_TYPE csa_type;
+    typedef typename csa_type::char_type char_type;
+    csa_type csa;
+    cache_config config(true, argv[2], util::basename(argv[1]));
+    construct(csa, argv[1], config, 1);
+    cout << "# CSA_ID = " << CSA_ID << endl;
+    cout << "# size = " << size_in_mega_bytes(csa) << endl;
+
+    const uint64_t queries = 100000;
+    std::mt19937_64 rng(17);
+    for (uint64_t m : {4, 8, 16, 32}) {
+        // patterns are substrings of the text, so each search runs over all m symbols
+        vector<vector<char_type>> patterns(queries);
+        for (auto& p : patterns) {
+            uint64_t pos = rng() % (csa.size()-m);
+            p.resize(m);
+            extract(csa, pos, pos+m-1, p.begin());
+        }
+        auto start = timer::now();
+        uint64_t check_two = 0;
+        for (const auto& p : patterns) {
+            check_two += count_two_ranks(csa, p.begin(), p.end());
+        }
+        auto stop = timer::now();
+        double two_rank_time = duration_cast<microseconds>(stop-start).count();
+        start = timer::now();
+        uint64_t check_pair = 0;
+        for (const auto& p : patterns) {
+            check_pair += sdsl::count(csa, p.begin(), p.end());
+        }
+        stop = timer::now();
+        double rank_pair_time = duration_cast<microseconds>(stop-start).count();
+        start = timer::now();
+        uint64_t check_batch = 0;
+        for (auto cnt : count_batch(csa, patterns)) {
+            check_batch += cnt;
+        }
+        stop = timer::now();
+        double batch_time = duration_cast<microseconds>(stop-start).count();
+        if (check_two != check_pair or check_pair != check_batch) {
+            cerr << "ERROR: count results differ for m = " << m << endl;
+            return 1;
+        }
+        cout << "# m = " << m << endl;
+        cout << "# two_rank_counts_per_sec = " << (uint64_t)(queries*1e6/two_rank_time) << endl;
+        cout << "# rank_pair_counts_per_sec = " << (uint64_t)(queries*1e6/rank_pair_time) << endl;
+        cout << "# batch_counts_per_sec = " << (uint64_t)(queries*1e6/batch_time) << endl;
+        cout << "# check = " << check_pair << endl;
+    }
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " length file" << endl;
+        cout << " generates a text of `length` bytes, which consists of words of a" << endl;
+        cout << " random vocabulary drawn from a Zipf distribution, and saves it to `file`." << endl;
+        cout << "`length` format:\n";
+        cout << "  X, where X is the length in number of bytes\n";
+        cout << "  XkB, where X is the length in number of kilobytes\n";
+        cout << "  XMB, where X is the length in number of megabytes\n";
+        cout << "  XGB, where X is the length in number of gigabytes\n";
+        return 1;
+    }
+    uint64_t length = atoll(argv[1]);
+    string length_str(argv[1]);
+    size_t Bpos = length_str.find_first_of("B");
+    if (Bpos != string::npos and Bpos > 1) {
+        char order = length_str.substr(Bpos-1,1)[0];
+        if (order == 'k' or order == 'K')
+            length <<= 10;
+        else if (order == 'm' or order == 'M')
+            length <<= 20;
+        else if (order == 'g' or order == 'G')
+            length <<= 30;
+    }
+    std::mt19937_64 rng(17);
+    const uint64_t words = 1<<16;
+    vector<string> vocabulary(words);
+    vector<double> weights(words);
+    for (uint64_t i=0; i < words; ++i) {
+        uint64_t len = 1 + rng() % 10;
+        for (uint64_t j=0; j < len; ++j) {
+            vocabulary[i] += (char)('a' + rng() % 26);
+        }
+        weights[i] = 1.0/(i+1);
+    }
+    std::discrete_distribution<uint64_t> zipf(weights.begin(), weights.end());
+    string text;
+    text.reserve(length+11);
+    while (text.size() < length) {
+        text += vocabulary[zipf(rng)];
+        text += (rng() % 16 == 0) ? '\n' : ' ';
+    }
+    text.resize(length);
+    ofstream out(argv[2], ios::binary);
+    out.write(text.data(), text.size());
+    return out ? 0 : 1;
+}
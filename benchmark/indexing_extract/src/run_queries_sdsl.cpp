@@ -3,6 +3,9 @@
  */
 #include <sdsl/suffix_arrays.hpp>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
 
 #include <stdlib.h>
 #include "interface.h"
@@ -27,10 +30,19 @@ using namespace std;
 void do_count(const CSA_TYPE&);
 void do_locate(const CSA_TYPE&);
 void do_extract(const CSA_TYPE&);
+void do_extract_lengths(const CSA_TYPE&, const vector<ulong>&);
 //void do_display(ulong length);
 void pfile_info(ulong* length, ulong* numpatt);
 //void output_char(uchar c, FILE * where);
 double getTime(void);
+double getWallTime(void);
+double
+getWallTime(void)
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
+
 void usage(char* progname);
 
 static int Verbose = 0;
@@ -247,6 +259,7 @@ do_extract(const CSA_TYPE& csa)
     ulong num_pos, from, to, numchars, tot_ext = 0;
     CSA_TYPE::size_type readlen = 0;
     double time, tot_time = 0;
+    vector<ulong> starts;
 
     error = fscanf(stdin, "# number=%lu length=%lu file=%s\n", &num_pos, &numchars, orig_file);
     if (error != 3) {
@@ -269,6 +282,7 @@ do_extract(const CSA_TYPE& csa)
         tot_time += (getTime() - time);
 
         tot_ext += readlen;
+        starts.push_back(from);
 
         if (Verbose) {
             fwrite(&from,sizeof(ulong),1,stdout);
@@ -286,6 +300,69 @@ do_extract(const CSA_TYPE& csa)
             (tot_time * 1000) / tot_ext);
     fprintf(stderr, "(Load_time+Extract_time)/Num_chars_extracted = %.4f\n\n",
             ((Load_time+tot_time) * 1000) / tot_ext);
+
+    do_extract_lengths(csa, starts);
+}
+
+/* Extracts snippets of length 100 to 100k from the interval starts with
+ * the classic extract and the segment engine. Each snippet length gets a
+ * budget of about 4M characters, and each variant runs in a separate pass
+ * over the snippets. The text sample holds the first 1000 characters of
+ * the snippets of every tenth start. Times are wall-clock times. */
+void
+do_extract_lengths(const CSA_TYPE& csa, const vector<ulong>& starts)
+{
+    const ulong max_len = 100000, budget = 4000000, hot_len = 1000;
+    ulong n = csa.size()-1; // without sentinel
+    if (starts.empty() or n == 0) {
+        return;
+    }
+    uint64_t threads = std::max(1U, std::thread::hardware_concurrency());
+    vector<pair<CSA_TYPE::size_type, CSA_TYPE::size_type>> hot;
+    for (size_t k=0; k < starts.size(); k += 10) {
+        hot.emplace_back(starts[k], std::min(starts[k]+hot_len, n)-1);
+    }
+    double time = getWallTime();
+    text_sample ts(csa, hot, 1024, threads);
+    fprintf(stderr, "# Text_sample_construction_time_in_sec = %.2f\n", getWallTime() - time);
+    fprintf(stderr, "# Text_sample_size_in_bytes = %lu\n", (ulong)size_in_bytes(ts));
+    fprintf(stderr, "# Extract_engine_threads = %lu\n", (ulong)threads);
+
+    const char* name[4] = {"classic", "engine_seq", "engine", "engine_sample"};
+    vector<uchar> expected, text(max_len);
+    for (ulong len = 100; len <= max_len; len *= 10) {
+        ulong queries = std::min((ulong)starts.size(), std::max((ulong)1, budget/len));
+        double t[4];
+        for (int v = 0; v < 4; ++v) {
+            ulong chars = 0;
+            time = getWallTime();
+            for (ulong k=0; k < queries; ++k) {
+                ulong from = starts[k];
+                ulong to = std::min(from+len, n)-1;
+                if (v == 0) {
+                    sdsl::extract(csa, from, to, text.begin());
+                } else if (v == 3) {
+                    sdsl::extract(csa, from, to, text.data(), ts, threads);
+                } else {
+                    sdsl::extract(csa, from, to, text.data(), v == 1 ? 1 : threads);
+                }
+                if (v == 0) {
+                    expected.insert(expected.end(), text.begin(), text.begin()+(to-from+1));
+                } else if (!std::equal(text.begin(), text.begin()+(to-from+1), expected.begin()+chars)) {
+                    fprintf(stderr, "Error: %s extract differs at [%lu,%lu]\n", name[v], from, to);
+                    exit(1);
+                }
+                chars += to-from+1;
+            }
+            t[v] = getWallTime() - time;
+            if (v == 0) {
+                fprintf(stderr, "# Extract_%lu_num_chars = %lu\n", len, chars);
+            }
+            fprintf(stderr, "# Extract_%lu_%s_ns_per_char = %.2f\n", len, name[v], 1e9*t[v]/chars);
+        }
+        fprintf(stderr, "# Extract_%lu_engine_speedup = %.2f\n\n", len, t[0]/t[2]);
+        expected.clear();
+    }
 }
 
 double
@@ -3,6 +3,9 @@
  */
 #include <sdsl/suffix_arrays.hpp>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
 
 #include <stdlib.h>
 #include "interface.h"
@@ -31,6 +34,14 @@ void do_extract(const CSA_TYPE&);
 void pfile_info(ulong* length, ulong* numpatt);
 //void output_char(uchar c, FILE * where);
 double getTime(void);
+double getWallTime(void);
+double
+getWallTime(void)
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
+
 void usage(char* progname);
 
 static int Verbose = 0;
@@ -168,8 +179,9 @@ do_locate(const CSA_TYPE& csa)
 {
     ulong numocc, length;
     ulong tot_numocc = 0, numpatt = 0, processed_pat = 0;
-    double time, tot_time = 0;
+    double time, tot_time = 0, wall_time = 0;
     uchar* pattern;
+    vector<string> patterns;
 
     pfile_info(&length, &numpatt);
 
@@ -187,10 +199,13 @@ do_locate(const CSA_TYPE& csa)
             exit(1);
         }
         // Locate
+        double wall = getWallTime();
         time = getTime();
         auto occs =  locate(csa, (char*)pattern, (char*)pattern+length);
         numocc = occs.size();
         tot_time += (getTime() - time);
+        wall_time += (getWallTime() - wall);
+        patterns.emplace_back((char*)pattern, length);
         ++processed_pat;
 
         tot_numocc += numocc;
@@ -209,6 +224,37 @@ do_locate(const CSA_TYPE& csa)
     fprintf(stderr, "# Locate_time/Num_occs = %.4f\n\n", (tot_time * 1000) / tot_numocc);
     fprintf(stderr, "# (Load_time+Locate_time)/Num_occs = %.4f\n\n", ((tot_time+Load_time) * 1000) / tot_numocc);
 
+    // Repeat the processed patterns with the lock-step locate engine,
+    // once sequentially and once on all hardware threads. Wall-clock
+    // times are compared, since getTime() sums the time of all threads.
+    uint64_t threads = std::max(1U, std::thread::hardware_concurrency());
+    vector<uint64_t> buf;
+    double engine_time[2] = {0, 0};
+    for (int pass = 0; pass < 2; ++pass) {
+        ulong engine_numocc = 0;
+        double wall = getWallTime();
+        for (const auto& pat : patterns) {
+            auto cnt = locate(csa, pat.begin(), pat.end(), buf.data(), buf.size(), pass ? threads : 1);
+            if (buf.size() < cnt) { // buffer was too small
+                buf.resize(cnt);
+                locate(csa, pat.begin(), pat.end(), buf.data(), buf.size(), pass ? threads : 1);
+            }
+            engine_numocc += cnt;
+        }
+        engine_time[pass] = getWallTime() - wall;
+        if (engine_numocc != tot_numocc) {
+            fprintf(stderr, "Error: locate engine found %lu instead of %lu occurrences\n", engine_numocc, tot_numocc);
+            exit(1);
+        }
+    }
+    fprintf(stderr, "# Locate_wall_time_in_secs = %.2f\n", wall_time);
+    fprintf(stderr, "# Locate_engine_threads = %lu\n", (ulong)threads);
+    fprintf(stderr, "# Locate_engine_seq_time_in_secs = %.2f\n", engine_time[0]);
+    fprintf(stderr, "# Locate_engine_time_in_secs = %.2f\n", engine_time[1]);
+    fprintf(stderr, "# Locate_engine_time/Num_occs = %.4f\n", (engine_time[1] * 1000) / tot_numocc);
+    fprintf(stderr, "# Locate_engine_seq_speedup = %.2f\n", wall_time / engine_time[0]);
+    fprintf(stderr, "# Locate_engine_speedup = %.2f\n\n", wall_time / engine_time[1]);
+
     free(pattern);
 }
 
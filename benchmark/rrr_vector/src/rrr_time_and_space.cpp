@@ -1,6 +1,8 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <sdsl/rrr_vector.hpp>
 
 using namespace std;
@@ -45,6 +47,38 @@ uint64_t test_inv_random_access(const t_vec& v, const int_vector<64>& rands, uin
     return cnt;
 }
 
+//! Answers rank queries in batches of `batch` queries with the prefetching rank method
+template<class t_rank>
+uint64_t test_batch_rank(const t_rank& r, const int_vector<64>& rands, uint64_t mask, uint64_t times=100000000, uint64_t batch=1024)
+{
+    uint64_t cnt=0;
+    std::vector<uint64_t> res(batch);
+    for (uint64_t i=0; i<times; i+=batch) {
+        uint64_t n = std::min(batch, times-i);
+        r.rank(rands.data() + (i&mask), n, res.data());
+        for (uint64_t j=0; j<n; ++j) {
+            cnt += res[j];
+        }
+    }
+    return cnt;
+}
+
+//! Answers select queries in batches of `batch` queries with the batched select method
+template<class t_select>
+uint64_t test_batch_select(const t_select& s, const int_vector<64>& rands, uint64_t mask, uint64_t times=100000000, uint64_t batch=1024)
+{
+    uint64_t cnt=0;
+    std::vector<uint64_t> res(batch);
+    for (uint64_t i=0; i<times; i+=batch) {
+        uint64_t n = std::min(batch, times-i);
+        s.select(rands.data() + (i&mask), n, res.data());
+        for (uint64_t j=0; j<n; ++j) {
+            cnt += res[j];
+        }
+    }
+    return cnt;
+}
+
 int main(int argc, char* argv[])
 {
     if (argc < 3) {
@@ -92,12 +126,22 @@ int main(int argc, char* argv[])
         stop = timer::now();
         cout << "# rank_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
         cout << "# rank_check = " << check << endl;
+        start = timer::now();
+        check = test_batch_rank(rrr_rank, rands, mask, reps);
+        stop = timer::now();
+        cout << "# rank_batch_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+        cout << "# rank_batch_check = " << check << endl;
         rands = util::rnd_positions<int_vector<64>>(20, mask, args, 17);
         for (uint64_t i=0; i<rands.size(); ++i) rands[i] = rands[i]+1;
-        stop = timer::now();
+        start = timer::now();
         check = test_inv_random_access(rrr_sel, rands, mask, reps);
         stop = timer::now();
         cout << "# select_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
         cout << "# select_check = " << check << endl;
+        start = timer::now();
+        check = test_batch_select(rrr_sel, rands, mask, reps);
+        stop = timer::now();
+        cout << "# select_batch_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+        cout << "# select_batch_check = " << check << endl;
     }
 }
@@ -2,6 +2,7 @@
 #include <random>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 using namespace sdsl;
 using namespace std;
@@ -119,4 +120,80 @@ int main()
         cout << "# rank1_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
         cout << "# select_check = " << check << endl;
     }
+    {
+        uint64_t mask = 0;
+        auto rands = util::rnd_positions<int_vector<64>>(20, mask, bv_sd.size(), 17);
+        sd_vector<>::rank_1_type rank1(&bv_sd);
+        sd_vector<>::select_1_type select1(&bv_sd);
+        const uint64_t reps = 10000000;
+        uint64_t check = 0;
+        start = timer::now();
+        for (uint64_t i=0; i<reps; ++i) {
+            auto r = rank1(rands[i&mask]);
+            check += r < ones ? select1(r+1) : bv_sd.size();
+        }
+        stop = timer::now();
+        cout << "# rank_select_successor_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+        cout << "# successor_check = " << check << endl;
+        check = 0;
+        start = timer::now();
+        for (uint64_t i=0; i<reps; ++i) {
+            check += bv_sd.successor(rands[i&mask]);
+        }
+        stop = timer::now();
+        cout << "# successor_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)reps << endl;
+        cout << "# successor_check = " << check << endl;
+    }
+    {
+        // intersect bv_sd with a sparser set by next_geq
+        std::vector<uint64_t> pos;
+        for (uint64_t i=0; i < bv_sd.size()/2000; ++i) {
+            pos.push_back(dice());
+        }
+        std::sort(pos.begin(), pos.end());
+        pos.erase(std::unique(pos.begin(), pos.end()), pos.end());
+        sd_vector<> sparse(pos.begin(), pos.end());
+        sd_vector<>::rank_1_type rank1(&bv_sd), rank1_sparse(&sparse);
+        sd_vector<>::select_1_type select1(&bv_sd), select1_sparse(&sparse);
+        // next_geq emulated by rank and select
+        auto next_geq = [](const sd_vector<>& v, sd_vector<>::rank_1_type& rank, sd_vector<>::select_1_type& select, uint64_t x) {
+            if (x >= v.size()) return v.size();
+            auto r = rank(x);
+            return r < v.low.size() ? select(r+1) : v.size();
+        };
+        uint64_t check = 0;
+        start = timer::now();
+        uint64_t a = next_geq(bv_sd, rank1, select1, 0), b = next_geq(sparse, rank1_sparse, select1_sparse, 0);
+        while (a < bv_sd.size() and b < sparse.size()) {
+            if (a == b) {
+                ++check;
+                a = next_geq(bv_sd, rank1, select1, a+1);
+                b = next_geq(sparse, rank1_sparse, select1_sparse, b+1);
+            } else if (a < b) {
+                a = next_geq(bv_sd, rank1, select1, b);
+            } else {
+                b = next_geq(sparse, rank1_sparse, select1_sparse, a);
+            }
+        }
+        stop = timer::now();
+        cout << "# rank_select_intersect_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)pos.size() << endl;
+        cout << "# intersect_check = " << check << endl;
+        check = 0;
+        start = timer::now();
+        sd_vector<>::cursor ca(bv_sd), cb(sparse);
+        while (!ca.end() and !cb.end()) {
+            if (ca.value() == cb.value()) {
+                ++check;
+                ca.next();
+                cb.next();
+            } else if (ca.value() < cb.value()) {
+                ca.next_geq(cb.value());
+            } else {
+                cb.next_geq(ca.value());
+            }
+        }
+        stop = timer::now();
+        cout << "# cursor_intersect_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)pos.size() << endl;
+        cout << "# intersect_check = " << check << endl;
+    }
 }
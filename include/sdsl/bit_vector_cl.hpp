@@ -0,0 +1,527 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file bit_vector_cl.hpp
+   \brief bit_vector_cl.hpp contains the sdsl::bit_vector_cl class, and
+          classes which support rank and select for bit_vector_cl.
+   \author Simon Gog
+*/
+#ifndef SDSL_BIT_VECTOR_CL
+#define SDSL_BIT_VECTOR_CL
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "iterators.hpp"
+
+#include <cstring>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class rank_support_cl;  // in bit_vector_cl
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class select_support_cl;  // in bit_vector_cl
+
+//! A bit vector which stores the rank information in the cache lines of the bits.
+/*!
+ * The original bit_vector is split into blocks of 448 bits. Each block is
+ * stored together with the number of set bits before the block in one
+ * 64-byte aligned line of eight 64-bit words. A rank query therefore touches
+ * a single cache line and adds at most seven popcounts of words in this line.
+ * In contrast to bit_vector_il, a block never straddles two cache lines.
+ *
+ * The space overhead is one word per seven words of the original bit_vector.
+ *
+ * \sa bit_vector_il, rank_support_cl, select_support_cl
+ */
+class bit_vector_cl
+{
+    public:
+        typedef bit_vector::size_type                       size_type;
+        typedef size_type                                   value_type;
+        typedef bit_vector::difference_type                 difference_type;
+        typedef random_access_const_iterator<bit_vector_cl> iterator;
+        typedef bv_tag                                      index_category;
+
+        friend class rank_support_cl<1>;
+        friend class rank_support_cl<0>;
+        friend class select_support_cl<1>;
+        friend class select_support_cl<0>;
+
+        typedef rank_support_cl<1>     rank_1_type;
+        typedef rank_support_cl<0>     rank_0_type;
+        typedef select_support_cl<1> select_1_type;
+        typedef select_support_cl<0> select_0_type;
+
+        enum { line_words = 8 };              //!< 64-bit words per line
+        enum { data_words = line_words-1 };   //!< 64-bit words of the bit_vector per line
+        enum { line_bits  = data_words*64 };  //!< Bits of the bit_vector per line
+    private:
+        size_type m_size   = 0;  //!< Size of the original bitvector
+        size_type m_lines  = 0;  //!< Number of lines
+        size_type m_offset = 0;  //!< Position of the first line in m_data, which is 64-byte aligned
+        int_vector<64> m_data;   //!< Lines and padding for the alignment
+
+        //! Moves the lines to the first 64-byte boundary of m_data.
+        /*! Has to be called whenever m_data is reallocated, i.e. after copy and load.
+         */
+        void align()
+        {
+            if (m_data.empty())
+                return;
+            uint64_t* p = m_data.data();
+            size_type offset = ((64 - ((uintptr_t)p & 63)) & 63) >> 3;
+            if (offset != m_offset) {
+                std::memmove(p + offset, p + m_offset, m_lines*line_words*sizeof(uint64_t));
+                m_offset = offset;
+            }
+        }
+
+        //! Allocates m_data with padding and copies the m_lines lines from p into it.
+        void copy_lines(const uint64_t* p)
+        {
+            m_data   = int_vector<64>(m_lines > 0 ? m_lines*line_words + line_words-1 : 0, 0);
+            m_offset = 0;
+            align();
+            if (m_lines > 0) {
+                std::memcpy(m_data.data() + m_offset, p, m_lines*line_words*sizeof(uint64_t));
+            }
+        }
+
+        //! Pointer to line l. The first word holds the number of set bits before the line.
+        const uint64_t* line(size_type l) const
+        {
+            return m_data.data() + m_offset + l*line_words;
+        }
+
+        //! Pointer to the word which contains bit i.
+        const uint64_t* word(size_type i) const
+        {
+            size_type w = i >> 6;
+            size_type l = w / data_words;
+            return line(l) + 1 + (w - l*data_words);
+        }
+
+    public:
+        bit_vector_cl() {}
+        bit_vector_cl(const bit_vector_cl& bv) : m_size(bv.m_size), m_lines(bv.m_lines)
+        {
+            copy_lines(bv.m_lines > 0 ? bv.line(0) : nullptr);
+        }
+        bit_vector_cl(bit_vector_cl&&) = default;
+        bit_vector_cl& operator=(const bit_vector_cl& bv)
+        {
+            if (this != &bv) {
+                bit_vector_cl tmp(bv);
+                swap(tmp);
+            }
+            return *this;
+        }
+        bit_vector_cl& operator=(bit_vector_cl&&) = default;
+
+        bit_vector_cl(const bit_vector& bv)
+        {
+            m_size  = bv.size();
+            // the line after the last complete block holds the total sum
+            m_lines = m_size / line_bits + 1;
+            m_data  = int_vector<64>(m_lines*line_words + line_words-1, 0);
+            m_offset = 0;
+            align();
+
+            const uint64_t* bvp = bv.data();
+            size_type words = (m_size+63)>>6;
+            size_type cum_sum = 0;
+            uint64_t* p = m_data.data() + m_offset;
+            for (size_type l=0, w=0; l < m_lines; ++l, p += line_words) {
+                p[0] = cum_sum;
+                for (size_type j=1; j < line_words and w < words; ++j, ++w) {
+                    p[j] = bvp[w];
+                    if (w+1 == words and (m_size&63)) {
+                        p[j] &= bits::lo_set[m_size&63];
+                    }
+                    cum_sum += bits::cnt(p[j]);
+                }
+            }
+        }
+
+        //! Accessing the i-th element of the original bit_vector
+        /*! \param i An index i with \f$ 0 \leq i < size()  \f$.
+         *  \return The i-th bit of the original bit_vector
+         *  \par Time complexity
+         *     \f$ \Order{1} \f$
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            return (*word(i) >> (i&63)) & 1ULL;
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *   \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, uint8_t len=64)const
+        {
+            assert(idx+len-1 < m_size);
+            const uint64_t* b = word(idx);
+            if ((idx&63)+len <= 64) {  // spans one word
+                return (*b >> (idx&63)) & bits::lo_set[len];
+            } else { // spans two words
+                uint8_t b_len = 64-(idx&63);
+                return (*b >> (idx&63))
+                       | (*word(idx+len-1) & bits::lo_set[len-b_len]) << b_len;
+            }
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Serializes the data structure into the given ostream
+        /*! The lines are written without the padding, so the output does not
+         *  depend on the alignment of the memory.
+         */
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_lines, out, child, "lines");
+            structure_tree_node* data_child = structure_tree::add_child(child, "data", util::class_name(m_data));
+            bool aligned = aligned_format::writing(out);
+            uint64_t offset = aligned ? (uint64_t)out.tellp() : 0;
+            size_type data_bytes = int_vector<64>::write_header(m_lines*line_words*64, 64, out);
+            if (aligned) {
+                data_bytes += aligned_format::pad(out);
+                aligned_format::record(data_child, offset, out.tellp(), m_lines*line_words*64, 64);
+            }
+            if (m_lines > 0) {
+                out.write((const char*)line(0), m_lines*line_words*sizeof(uint64_t));
+                data_bytes += m_lines*line_words*sizeof(uint64_t);
+            }
+            structure_tree::add_size(data_child, data_bytes);
+            written_bytes += data_bytes;
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_lines, in);
+            size_type data_size;
+            uint8_t width;
+            int_vector<64>::read_header(data_size, width, in);
+            aligned_format::skip(in);
+            // a mapped payload is used in place if its lines start on a 64-byte boundary
+            if (memory_manager::map_payload(m_data, data_size, in)) {
+                m_offset = 0;
+                if (m_lines > 0 and ((uintptr_t)m_data.data() & 63)) {
+                    int_vector<64> mapped;
+                    mapped.swap(m_data);
+                    copy_lines(mapped.data());
+                }
+                return;
+            }
+            m_data   = int_vector<64>(m_lines > 0 ? m_lines*line_words + line_words-1 : 0);
+            m_offset = 0;
+            align();
+            if (m_lines > 0) {
+                in.read((char*)(m_data.data() + m_offset), m_lines*line_words*sizeof(uint64_t));
+            }
+        }
+
+        void swap(bit_vector_cl& bv)
+        {
+            if (this != &bv) {
+                std::swap(m_size, bv.m_size);
+                std::swap(m_lines, bv.m_lines);
+                std::swap(m_offset, bv.m_offset);
+                m_data.swap(bv.m_data);
+            }
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, size());
+        }
+};
+
+//! Rank support for bit_vector_cl.
+/*! Reads the sum in front of the line of position i and adds the popcounts
+ *  of the preceding words in the same line.
+ */
+template<uint8_t t_b>
+class rank_support_cl
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_support_cl only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector_cl         bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+        inline size_type rank1(size_type i) const
+        {
+            size_type w = i >> 6;
+            size_type l = w / bit_vector_type::data_words;
+            size_type k = w - l*bit_vector_type::data_words;
+            const uint64_t* p = m_v->line(l);
+            uint64_t res = p[0];
+            // branchless: all words of the line are counted, the ones after word k are masked out
+            for (size_type j=0; j < bit_vector_type::data_words; ++j) {
+                uint64_t mask = j < k ? bits::all_set : (j == k ? bits::lo_set[i&63] : 0);
+                res += bits::cnt(p[1+j] & mask);
+            }
+            return res;
+        }
+
+    public:
+
+        rank_support_cl(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the number of occurrences of the bit pattern in [0..i-1].
+        size_type rank(size_type i) const
+        {
+            assert(i <= m_v->size());
+            if (t_b) return rank1(i);
+            return i - rank1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        //! Prefetches the memory which is accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            __builtin_prefetch(m_v->line((i>>6) / bit_vector_type::data_words));
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_cl::rank(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_cl& operator=(const rank_support_cl& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_cl&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select support for bit_vector_cl.
+/*! The line of every sample_rate-th occurrence is sampled. A query
+ *  searches the line between two samples by the sums stored in the lines
+ *  and then scans the words of the found line.
+ */
+template<uint8_t t_b>
+class select_support_cl
+{
+        static_assert(t_b == 1 or t_b == 0 , "select_support_cl only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector_cl         bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+        enum { sample_rate = 2048 };
+    private:
+        const bit_vector_type* m_v = nullptr;
+        int_vector<> m_samples;  //!< Line of the (k*sample_rate+1)-th occurrence, followed by the last line
+
+        //! Number of occurrences before line l.
+        size_type args_before(size_type l) const
+        {
+            size_type ones = *(m_v->line(l));
+            return t_b ? ones : l*bit_vector_type::line_bits - ones;
+        }
+
+        static uint64_t args_in_word(uint64_t w)
+        {
+            return t_b ? w : ~w;
+        }
+
+    public:
+
+        select_support_cl(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+            if (v == nullptr)
+                return;
+            size_type lines = v->m_lines;
+            const uint64_t* last = v->line(lines-1);
+            size_type ones  = last[0] + bits::cnt(last+1, bit_vector_type::data_words);
+            size_type total = t_b ? ones : v->size() - ones;
+            size_type sample_cnt = (total+sample_rate-1)/sample_rate;
+            m_samples = int_vector<>(sample_cnt+1, 0, bits::hi(lines)+1);
+            size_type k = 0, next = 1;
+            for (size_type l=0; l+1 < lines and k < sample_cnt; ++l) {
+                size_type end = args_before(l+1);
+                while (k < sample_cnt and next <= end) {
+                    m_samples[k++] = l;
+                    next += sample_rate;
+                }
+            }
+            while (k < sample_cnt) {  // occurrences in the last line
+                m_samples[k++] = lines-1;
+            }
+            m_samples[sample_cnt] = lines-1;
+        }
+
+        //! Returns the position of the i-th occurrence in the bit vector.
+        size_type select(size_type i) const
+        {
+            size_type k  = (i-1)/sample_rate;
+            size_type lb = m_samples[k], rb = m_samples[k+1];
+            // find the last line l in [lb..rb] with args_before(l) < i
+            while (lb < rb) {
+                size_type mid = lb + (rb-lb+1)/2;
+                if (args_before(mid) < i) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            i -= args_before(lb);
+            const uint64_t* p = m_v->line(lb) + 1;
+            size_type res = lb * bit_vector_type::line_bits;
+            uint64_t w = args_in_word(*p);
+            size_type args = bits::cnt(w);
+            while (args < i) {
+                i -= args;
+                w = args_in_word(*(++p));
+                args = bits::cnt(w);
+                res += 64;
+            }
+            return res + bits::sel(w, i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        //! Prefetches the samples which are accessed by select(i).
+        void prefetch(size_type i)const
+        {
+            util::prefetch(m_samples, (i-1)/sample_rate);
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_support_cl::select(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_cl& operator=(const select_support_cl& ss)
+        {
+            if (this != &ss) {
+                m_samples = ss.m_samples;
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_cl& ss)
+        {
+            m_samples.swap(ss.m_samples);
+        }
+
+        void load(std::istream& in, const bit_vector_type* v=nullptr)
+        {
+            m_samples.load(in);
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = m_samples.serialize(out, child, "samples");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+};
+
+} // end namespace sdsl
+#endif
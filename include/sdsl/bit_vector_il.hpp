@@ -315,6 +315,27 @@ class rank_support_il
             return rank(i);
         }
 
+        //! Prefetches the memory which is accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            size_type SBlockNum = i >> m_block_shift;
+            size_type SBlockPos = (SBlockNum << m_block_size_U64) + SBlockNum;
+            __builtin_prefetch(m_v->m_data.data() + SBlockPos);
+            __builtin_prefetch(m_v->m_data.data() + SBlockPos + 1 + ((i&m_block_mask)>>6));
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_il::rank(i); });
+        }
+
         size_type size()const
         {
             return m_v->size();
@@ -485,6 +506,16 @@ class select_support_il
             return select(i);
         }
 
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The superblock is found by binary search, so the queries are not prefetched.
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            for (size_t j=0; j < n; ++j) {
+                out[j] = select(args[j]);
+            }
+        }
+
         size_type size()const
         {
             return m_v->size();
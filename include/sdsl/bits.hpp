@@ -27,6 +27,9 @@
 #ifdef __SSE4_2__
 #include <xmmintrin.h>
 #endif
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -102,6 +105,33 @@ struct bits {
      */
     static uint64_t cnt(uint64_t x);
 
+    //! Counts the number of set bits in the words data[0..n-1].
+    /*! Uses the fastest kernel supported by the CPU (see cpu_features).
+        \param data Pointer to the first word.
+        \param n    Number of 64-bit words.
+        \return Number of set bits.
+     */
+    static uint64_t cnt(const uint64_t* data, uint64_t n);
+
+    //! Instruction set extensions which are used by dispatched methods.
+    enum cpu_feature : uint32_t {
+        CPU_POPCNT           = 1,
+        CPU_BMI2             = 2, // only set if pdep is not microcoded
+        CPU_AVX2             = 4,
+        CPU_AVX512_VPOPCNTDQ = 8
+    };
+
+    //! Features of the executing CPU, detected at program start.
+    /*! The bulk cnt and, in builds without -msse4.2 or -mbmi2, sel dispatch
+        on this value, so one binary can be run on different hosts.
+        Features can be masked out to compare kernels.
+        \sa detect_cpu_features
+     */
+    static uint32_t cpu_features;
+
+    //! Returns the cpu_feature flags of the executing CPU.
+    static uint32_t detect_cpu_features();
+
     //! Position of the most significant set bit the 64-bit word x
     /*! \param x 64-bit word
         \return The position (in 0..63) of the most significant set bit
@@ -169,6 +199,8 @@ struct bits {
      */
     static uint32_t sel(uint64_t x, uint32_t i);
     static uint32_t _sel(uint64_t x, uint32_t i);
+    //! Variant of sel which uses pdep, requires CPU_BMI2.
+    static uint32_t sel_bmi2(uint64_t x, uint32_t i);
 
     //! Calculates the position of the i-th rightmost 11-bit-pattern which terminates a Fibonacci coded integer in x.
     /*!	\param x 64 bit integer.
@@ -202,6 +234,23 @@ struct bits {
     //! Reads a value from a bit position in an array and moved the bit-pointer.
     static uint64_t read_int_and_move(const uint64_t*& word, uint8_t& offset, const uint8_t len=64);
 
+    //! Reads n values of width len, which start at bit position idx in an array.
+    /*! Whole blocks of 64 values, which start at a word boundary, are decoded
+        by kernels specialized for len. For len in {8,16,32} AVX2 kernels are
+        used if the CPU supports them (see cpu_features).
+        \param data Pointer to the array.
+        \param idx  Bit position of the first value.
+        \param len  Width of the values; len in [1..64].
+        \param n    Number of values.
+        \param out  Receives the values; out[0..n-1].
+     */
+    static void read_ints(const uint64_t* data, uint64_t idx, uint8_t len, uint64_t n, uint64_t* out);
+
+    //! Writes in[0..n-1] as values of width len to bit position idx in an array.
+    /*! The counterpart of read_ints. Bits outside of [idx..idx+n*len-1] are not changed.
+     */
+    static void write_ints(uint64_t* data, uint64_t idx, uint8_t len, uint64_t n, const uint64_t* in);
+
     //! Reads an unary decoded value from a bit position in an array.
     static uint64_t read_unary(const uint64_t* word, uint8_t offset=0);
 
@@ -319,7 +368,9 @@ inline uint64_t bits::map01(uint64_t x, uint64_t c)
 
 inline uint32_t bits::sel(uint64_t x, uint32_t i)
 {
-#ifdef __SSE4_2__
+#ifdef __BMI2__
+    return __builtin_ctzll(_pdep_u64(1ULL<<(i-1), x));
+#elif defined(__SSE4_2__)
     uint64_t s = x, b;
     s = s-((s>>1) & 0x5555555555555555ULL);
     s = (s & 0x3333333333333333ULL) + ((s >> 2) & 0x3333333333333333ULL);
@@ -337,8 +388,13 @@ inline uint32_t bits::sel(uint64_t x, uint32_t i)
     s <<= 8;
     i -= (s >> (byte_nr<<3)) & 0xFFULL;
     return (byte_nr << 3) + lt_sel[((i-1) << 8) + ((x>>(byte_nr<<3))&0xFFULL) ];
-#endif
+#else
+    // the call to sel_bmi2 only pays off against the branchy _sel
+    if (cpu_features & CPU_BMI2) {
+        return sel_bmi2(x, i);
+    }
     return _sel(x, i);
+#endif
 }
 
 inline uint32_t bits::_sel(uint64_t x, uint32_t i)
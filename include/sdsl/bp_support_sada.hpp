@@ -26,7 +26,6 @@
 #include "rank_support.hpp"
 #include "select_support.hpp"
 #include "bp_support_algorithm.hpp"
-#include "fast_cache.hpp"
 #include <stack>
 #include <map>
 #include <set>
@@ -94,12 +93,6 @@ class bp_support_sada
         size_type m_sml_blocks       = 0; // number of small sized blocks
         size_type m_med_blocks       = 0; // number of medium sized blocks
         size_type m_med_inner_blocks = 0; // number of inner nodes in the min max tree of the medium sized blocks
-//#define USE_CACHE
-#ifdef USE_CACHE
-        mutable fast_cache find_close_cache;
-        mutable fast_cache find_open_cache;
-        mutable fast_cache select_cache;
-#endif
 
         void copy(const bp_support_sada& bp_support) {
             m_bp        = bp_support.m_bp;
@@ -493,16 +486,6 @@ class bp_support_sada
          * \post{ \f$ 0\leq select(i) < size() \f$ }
          */
         size_type select(size_type i)const {
-#ifdef USE_CACHE
-            size_type a = 0;
-            if (select_cache.exists(i, a)) {
-                return a;
-            } else {
-                a = m_bp_select(i);
-                select_cache.write(i, a);
-                return a;
-            }
-#endif
             return m_bp_select(i);
         }
 
@@ -517,16 +500,6 @@ class bp_support_sada
             if (!(*m_bp)[i]) {// if there is a closing parenthesis at index i return i
                 return i;
             }
-#ifdef USE_CACHE
-            size_type a = 0;
-            if (find_close_cache.exists(i, a)) {
-                return a;
-            } else {
-                a = fwd_excess(i, -1);
-                find_close_cache.write(i, a);
-                return a;
-            }
-#endif
             return fwd_excess(i, -1);
         }
 
@@ -541,20 +514,6 @@ class bp_support_sada
             if ((*m_bp)[i]) {// if there is a opening parenthesis at index i return i
                 return i;
             }
-#ifdef USE_CACHE
-            size_type a = 0;
-            if (find_open_cache.exists(i, a)) {
-                return a;
-            } else {
-                size_type bwd_ex = bwd_excess(i,0);
-                if (bwd_ex == size())
-                    a = size();
-                else
-                    a = bwd_ex+1;
-                find_open_cache.write(i, a);
-                return a;
-            }
-#endif
             size_type bwd_ex = bwd_excess(i,0);
             if (bwd_ex == size())
                 return size();
@@ -4,6 +4,8 @@
 #include "uintx_t.hpp"
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace sdsl
 {
@@ -23,14 +25,23 @@ const char KEY_TEXT_INT[] 	= "text_int";
 const char KEY_PSI[] 		= "psi";
 const char KEY_LCP[] 		= "lcp";
 const char KEY_SAMPLE_CHAR[]= "sample_char";
+const char KEY_SA_SAMPLES[] = "sa_samples";
 }
 typedef uint64_t int_vector_size_type;
 
 typedef std::map<std::string, std::string> tMSS;
 
+typedef std::vector<std::pair<std::string, double>> tVSD;
+
 enum format_type {JSON_FORMAT, R_FORMAT, HTML_FORMAT};
 
-enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS};
+enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS, PARALLEL_DOUBLING};
+
+enum int_sa_algo_type {QSUFSORT, SAIS_INT, PARALLEL_DOUBLING_INT};
+
+enum lcp_algo_type {LCP_SEMI_EXTERN_PHI, LCP_PHI, LCP_PARALLEL_PHI, LCP_GO, LCP_BWT_BASED2};
+
+enum bwt_algo_type {BWT_FROM_SA, BWT_SA_FREE};
 
 //! Helper class for construction process
 struct cache_config {
@@ -42,7 +53,14 @@ struct cache_config {
     // a concatenation of PID and a unique ID inside the
     // current process.
     tMSS 		file_map;		// Files stored during the construction process.
-    cache_config(bool f_delete_files=true, std::string f_dir="./", std::string f_id="", tMSS f_file_map=tMSS());
+    uint64_t    ram_budget;     // Main memory (in bytes) available for the construction.
+    // If ram_budget is not 0, construct() chooses the fastest
+    // algorithms which fit into the budget (see plan_construction).
+    tVSD        stage_times;    // Wall-clock time (in seconds) of the construction stages
+    // in order of completion. Appended by construct().
+    uint64_t    kmer_table_budget; // Main memory (in bytes) available for the k-mer
+    // table of a CSA (see kmer_table). 0 means no budget.
+    cache_config(bool f_delete_files=true, std::string f_dir="./", std::string f_id="", tMSS f_file_map=tMSS(), uint64_t f_ram_budget=0);
 };
 
 //! Helper classes to transform width=0 and width=8 to corresponding text key
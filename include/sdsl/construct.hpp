@@ -90,6 +90,19 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     construct(idx, file, config, num_bytes, index_tag);
 }
 
+//! Chooses the construction algorithms for the cached text according to config.ram_budget.
+/*!
+ * \param config Cache configuration. The text has to be cached.
+ * \sa plan_construction(uint64_t, uint8_t, uint8_t, uint64_t, uint64_t)
+ */
+template<uint8_t t_width>
+construct_plan plan_construction(const cache_config& config, uint64_t sample_dens=0, bool sa_free=false)
+{
+    int_vector_buffer<t_width> text_buf(cache_file_name(key_text_trait<t_width>::KEY_TEXT, config));
+    return plan_construction(text_buf.size(), t_width, text_buf.width(), config.ram_budget,
+                             construct_config::num_threads, sample_dens, sa_free);
+}
+
 // Specialization for WTs
 template<class t_index>
 void construct(t_index& idx, const std::string& file, cache_config& config, uint8_t num_bytes, wt_tag)
@@ -109,9 +122,9 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     sdsl::remove(tmp_file_name);
 }
 
-// Specialization for CSAs
+// Constructs a CSA; sa_needed keeps the SA for a following LCP construction.
 template<class t_index>
-void construct(t_index& idx, const std::string& file, cache_config& config, uint8_t num_bytes, csa_tag)
+void _construct_csa(t_index& idx, const std::string& file, cache_config& config, uint8_t num_bytes, bool sa_needed)
 {
     auto event = memory_monitor::event("construct CSA");
     const char* KEY_TEXT = key_text_trait<t_index::alphabet_category::WIDTH>::KEY_TEXT;
@@ -119,6 +132,7 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     typedef int_vector<t_index::alphabet_category::WIDTH> text_type;
     {
         auto event = memory_monitor::event("parse input text");
+        stage_timer timer(config.stage_times, "parse input text");
         // (1) check, if the text is cached
         if (!cache_file_exists(KEY_TEXT, config)) {
             text_type text;
@@ -130,9 +144,28 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
         }
         register_cache_file(KEY_TEXT, config);
     }
-    {
+    construct_config_guard config_guard;
+    // The SA is only needed for the samples, if the samplings are sparse
+    const bool sa_free_possible = !sa_needed
+                                  and t_index::alphabet_category::WIDTH == 8
+                                  and t_index::sa_sample_dens > 1
+                                  and sa_samples_trait<typename t_index::sa_sample_type>::value
+                                  and sa_samples_trait<typename t_index::isa_sample_type>::value
+                                  and !cache_file_exists(conf::KEY_SA, config);
+    construct_plan plan;
+    if (config.ram_budget > 0) {
+        plan = plan_construction<t_index::alphabet_category::WIDTH>(config,
+                std::min((uint64_t)t_index::sa_sample_dens, (uint64_t)t_index::isa_sample_dens), sa_free_possible);
+        plan.apply();
+        memory_monitor::event("plan: " + plan.sa_info(t_index::alphabet_category::WIDTH) + ", "
+                              + plan.bwt_info() + ", " + plan.isa_info()
+                              + (std::max(std::max(plan.sa_bytes, plan.bwt_bytes), plan.isa_bytes) > plan.ram_budget ? " exceeds budget" : ""));
+    }
+    const bool sa_free = sa_free_possible and construct_config::bwt_algo == BWT_SA_FREE;
+    if (!sa_free) {
         // (2) check, if the suffix array is cached
-        auto event = memory_monitor::event("SA");
+        auto event = memory_monitor::event(config.ram_budget > 0 ? plan.sa_info(t_index::alphabet_category::WIDTH) : "SA");
+        stage_timer timer(config.stage_times, "SA");
         if (!cache_file_exists(conf::KEY_SA, config)) {
             construct_sa<t_index::alphabet_category::WIDTH>(config);
         }
@@ -140,15 +173,27 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     }
     {
         //  (3) construct BWT
-        auto event = memory_monitor::event("BWT");
+        auto event = memory_monitor::event(sa_free ? "BWT (SA free)" : (config.ram_budget > 0 ? plan.bwt_info() : "BWT"));
+        stage_timer timer(config.stage_times, sa_free ? "BWT (SA free)" : "BWT");
         if (!cache_file_exists(KEY_BWT, config)) {
-            construct_bwt<t_index::alphabet_category::WIDTH>(config);
+            if (sa_free) {
+                construct_bwt_sa_free(config);
+            } else {
+                construct_bwt<t_index::alphabet_category::WIDTH>(config);
+            }
         }
         register_cache_file(KEY_BWT, config);
     }
+    if (sa_free) {
+        //  (3b) compute the SA values needed by the samplings; they depend on the densities and are not reused
+        auto event = memory_monitor::event("SA samples");
+        stage_timer timer(config.stage_times, "SA samples");
+        construct_sa_samples(config, t_index::sa_sample_dens, t_index::isa_sample_dens);
+    }
     {
-        //  (4) use BWT to construct the CSA
+        //  (4) use BWT to construct the CSA; the CSA adds the times of its own stages
         auto event = memory_monitor::event("construct CSA");
+        stage_timer timer(config.stage_times, "construct CSA");
         t_index tmp(config);
         idx.swap(tmp);
     }
@@ -158,6 +203,13 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     }
 }
 
+// Specialization for CSAs
+template<class t_index>
+void construct(t_index& idx, const std::string& file, cache_config& config, uint8_t num_bytes, csa_tag)
+{
+    _construct_csa(idx, file, config, num_bytes, false);
+}
+
 // Specialization for CSTs
 template<class t_index>
 void construct(t_index& idx, const std::string& file, cache_config& config, uint8_t num_bytes, cst_tag)
@@ -165,28 +217,42 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     auto event = memory_monitor::event("construct CST");
     const char* KEY_TEXT = key_text_trait<t_index::alphabet_category::WIDTH>::KEY_TEXT;
     const char* KEY_BWT  = key_bwt_trait<t_index::alphabet_category::WIDTH>::KEY_BWT;
-    csa_tag csa_t;
+    construct_config_guard config_guard;
+    construct_plan plan;
     {
         // (1) check, if the compressed suffix array is cached
         typename t_index::csa_type csa;
         if (!cache_file_exists(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config)) {
-            cache_config csa_config(false, config.dir, config.id, config.file_map);
-            construct(csa, file, csa_config, num_bytes, csa_t);
+            cache_config csa_config(false, config.dir, config.id, config.file_map, config.ram_budget);
+            _construct_csa(csa, file, csa_config, num_bytes, true); // the LCP construction needs the SA
             auto event = memory_monitor::event("store CSA");
             config.file_map = csa_config.file_map;
+            config.stage_times.insert(config.stage_times.end(), csa_config.stage_times.begin(), csa_config.stage_times.end());
             store_to_cache(csa,std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config);
         }
         register_cache_file(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config);
     }
     {
         // (2) check, if the longest common prefix array is cached
-        auto event = memory_monitor::event("LCP");
         register_cache_file(KEY_TEXT, config);
         register_cache_file(KEY_BWT, config);
         register_cache_file(conf::KEY_SA, config);
+        if (config.ram_budget > 0 and !cache_file_exists(conf::KEY_LCP, config)) {
+            plan = plan_construction<t_index::alphabet_category::WIDTH>(config);
+            plan.apply();
+            memory_monitor::event("plan: " + plan.lcp_info() + (plan.lcp_bytes > plan.ram_budget ? " exceeds budget" : ""));
+        }
+        auto event = memory_monitor::event(config.ram_budget > 0 ? plan.lcp_info() : "LCP");
+        stage_timer timer(config.stage_times, "LCP");
         if (!cache_file_exists(conf::KEY_LCP, config)) {
-            if (t_index::alphabet_category::WIDTH==8) {
+            if (construct_config::lcp_algo == LCP_PARALLEL_PHI) {
+                construct_lcp_PHI_parallel<t_index::alphabet_category::WIDTH>(config);
+            } else if (t_index::alphabet_category::WIDTH==8 and construct_config::lcp_algo == LCP_SEMI_EXTERN_PHI) {
                 construct_lcp_semi_extern_PHI(config);
+            } else if (t_index::alphabet_category::WIDTH==8 and construct_config::lcp_algo == LCP_GO) {
+                construct_lcp_go(config);
+            } else if (t_index::alphabet_category::WIDTH==8 and construct_config::lcp_algo == LCP_BWT_BASED2) {
+                construct_lcp_bwt_based2(config);
             } else {
                 construct_lcp_PHI<t_index::alphabet_category::WIDTH>(config);
             }
@@ -195,6 +261,7 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     }
     {
         auto event = memory_monitor::event("CST");
+        stage_timer timer(config.stage_times, "CST");
         t_index tmp(config);
         tmp.swap(idx);
     }
@@ -22,9 +22,12 @@
 #define INCLUDED_SDSL_CONSTRUCT_BWT
 
 #include "int_vector.hpp"
+#include "rank_support.hpp"
 #include "sfstream.hpp"
 #include "util.hpp"
 #include "config.hpp" // for cache_config
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
 
 #include <iostream>
 #include <stdexcept>
@@ -39,6 +42,8 @@ namespace sdsl
  *  \param config	Reference to cache configuration
  *  \par Space complexity
  *		\f$ n \log \sigma \f$ bits
+ *  If construct_config::pipeline is set, reading the SA from disk and
+ *  writing the BWT overlap on two threads.
  *  \pre Text and Suffix array exist in the cache. Keys:
  *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
  *         * conf::KEY_SA
@@ -70,13 +75,112 @@ void construct_bwt(cache_config& config)
 
     //  (3) Construct BWT sequentially by streaming SA and random access to text
     size_type to_add[2] = {(size_type)-1,n-1};
-    for (size_type i=0; i < n; ++i) {
-        bwt_buf[i] = text[ sa_buf[i]+to_add[sa_buf[i]==0] ];
+    if (construct_config::pipeline and construct_config::num_threads > 1) {
+        // The next chunk of SA is read while the BWT of the current chunk is written
+        std::vector<uint64_t> chunk[2];
+        auto read_chunk = [&](size_type k) {
+            size_type b = k*buffer_size, e = std::min(n, b+buffer_size);
+            chunk[k%2].resize(e-b);
+            sa_buf.get_range(b, e, chunk[k%2].data());
+        };
+        size_type chunks = (n+buffer_size-1)/buffer_size;
+        read_chunk(0);
+        for (size_type k=0; k < chunks; ++k) {
+            parallel::run(k+1 < chunks ? 2 : 1, [&](uint64_t t) {
+                if (t == 0) {
+                    const std::vector<uint64_t>& sa = chunk[k%2];
+                    for (size_type i=0, j=k*buffer_size; i < sa.size(); ++i, ++j) {
+                        bwt_buf[j] = text[ sa[i]+to_add[sa[i]==0] ];
+                    }
+                } else {
+                    read_chunk(k+1);
+                }
+            });
+        }
+    } else {
+        for (size_type i=0; i < n; ++i) {
+            bwt_buf[i] = text[ sa_buf[i]+to_add[sa_buf[i]==0] ];
+        }
     }
     bwt_buf.close();
     register_cache_file(KEY_BWT, config);
 }
 
+//! Constructs the BWT of a text over a byte-alphabet without writing the suffix array.
+/*!	The BWT is induced directly from the sorted type B* suffixes (DivSufSort).
+ *  \param config	Reference to cache configuration
+ *  \par Space complexity
+ *		\f$ 5n \f$ bytes for input < 2GB and \f$ 9n \f$ bytes otherwise;
+ *      no suffix array is written to disk.
+ *  \pre Text exist in the cache. Key
+ *         * conf::KEY_TEXT
+ *  \post BWT exist in the cache. Key
+ *         * conf::KEY_BWT
+ */
+void construct_bwt_sa_free(cache_config& config);
+
+//! Computes the SA values needed by SA and ISA samplings with the given densities from the BWT.
+/*!	The rows are visited in text order by LF-mapping on a temporary
+ *  Huffman-shaped wavelet tree of the BWT. A row is stored if it is a
+ *  multiple of sa_sample_dens or if its SA value is a multiple of
+ *  sa_sample_dens or isa_sample_dens.
+ *  \param config	Reference to cache configuration
+ *  \param sa_sample_dens  Sample density of the SA sampling.
+ *  \param isa_sample_dens Sample density of the ISA sampling.
+ *  \par Space complexity
+ *		\f$ n(H_0+2) + 3\frac{n}{d}\log n \f$ bits, where \f$d\f$ is the smaller density
+ *  \pre BWT exist in the cache. Key
+ *         * conf::KEY_BWT
+ *  \post The samples exist in the cache. Key
+ *         * conf::KEY_SA_SAMPLES
+ *  \sa sa_samples_buffer
+ */
+void construct_sa_samples(cache_config& config, uint64_t sa_sample_dens, uint64_t isa_sample_dens);
+
+//! Access to the SA values stored under conf::KEY_SA_SAMPLES.
+/*! Used instead of the suffix array if the index is constructed with
+ *  construct_config::bwt_algo == BWT_SA_FREE. Rows which were not sampled
+ *  return 1, which is not a multiple of any sample density > 1.
+ *  \sa construct_sa_samples
+ */
+class sa_samples_buffer
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+    private:
+        bit_vector        m_marked;
+        rank_support_v5<> m_rank_marked;
+        int_vector<>      m_values;
+    public:
+        sa_samples_buffer(const cache_config& cconfig)
+        {
+            isfstream in(cache_file_name(conf::KEY_SA_SAMPLES, cconfig), std::ios::binary | std::ios::in);
+            if (!in) {
+                throw std::ios_base::failure("sa_samples_buffer: Cannot load SA samples from file system!");
+            }
+            m_marked.load(in);
+            m_values.load(in);
+            util::init_support(m_rank_marked, &m_marked);
+        }
+
+        size_type size() const
+        {
+            return m_marked.size();
+        }
+
+        //! SA value of row i if it was sampled, 1 otherwise
+        uint64_t operator[](size_type i)
+        {
+            return m_marked[i] ? m_values[m_rank_marked(i)] : 1;
+        }
+};
+
+//! Indicates if a sampling can be constructed from conf::KEY_SA_SAMPLES instead of the suffix array.
+template<class t_sampling>
+struct sa_samples_trait {
+    enum { value = false };
+};
+
 }// end namespace
 
 #endif
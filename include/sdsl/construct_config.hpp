@@ -2,6 +2,7 @@
 #define INCLUDED_SDSL_CONSTRUCT_CONFIG
 
 #include "config.hpp"
+#include <chrono>
 
 namespace sdsl
 {
@@ -10,10 +11,115 @@ class construct_config
 {
     public:
         static byte_sa_algo_type byte_algo_sa;
+        static int_sa_algo_type int_algo_sa;
+        static lcp_algo_type lcp_algo; // LCP algorithm used by construct(.., cst_tag)
+        static bwt_algo_type bwt_algo; // BWT_SA_FREE lets construct(.., csa_tag) skip the SA if the samplings allow it
+        static uint64_t num_threads; // Number of threads used by parallel construction algorithms; 1 by default, since each thread needs extra memory
+        static bool pipeline; // Overlap independent stages of construct(.., csa_tag) if num_threads > 1
+        static bool wm_semi_external; // wm_int streams the partitioned levels through temporary files
 
         construct_config() = delete;
 };
 
+//! Algorithms selected by plan_construction and their estimated memory peaks (in bytes).
+struct construct_plan {
+    byte_sa_algo_type byte_algo_sa = LIBDIVSUFSORT;
+    int_sa_algo_type  int_algo_sa  = QSUFSORT;
+    lcp_algo_type     lcp_algo     = LCP_SEMI_EXTERN_PHI;
+    bwt_algo_type     bwt_algo     = BWT_FROM_SA;
+    uint64_t sa_bytes  = 0;
+    uint64_t bwt_bytes = 0;
+    uint64_t isa_bytes = 0; // SA and ISA samples of the CSA
+    uint64_t lcp_bytes = 0;
+    uint64_t ram_budget = 0;
+
+    //! Estimated peak of the whole construction
+    uint64_t peak_bytes() const;
+    //! True if every phase fits into the budget
+    bool fits() const {
+        return peak_bytes() <= ram_budget;
+    }
+    //! Writes the selected algorithms into construct_config
+    void apply() const;
+    //! Description of the plan; used for the memory_monitor events
+    std::string sa_info(uint8_t width) const;
+    std::string bwt_info() const;
+    std::string isa_info() const;
+    std::string lcp_info() const;
+};
+
+//! Chooses the fastest SA, BWT, ISA sample and LCP construction algorithms which fit into a main memory budget.
+/*!
+ * \param n           Length of the text including the sentinel.
+ * \param width       0 for integer alphabet, 8 for byte alphabet.
+ * \param text_width  Bit-width of the text symbols.
+ * \param ram_budget  Available main memory in bytes.
+ * \param num_threads Number of threads available to the construction.
+ * \param sample_dens Smaller one of the SA and ISA sample densities of the
+ *                    CSA; 0 if no samples are constructed.
+ * \param sa_free     True if the samples may be taken without the SA
+ *                    (see BWT_SA_FREE).
+ *
+ * If no algorithm of a phase fits into the budget, the most space
+ * efficient one is chosen. The estimates follow the space complexities
+ * documented at the construction functions.
+ */
+construct_plan plan_construction(uint64_t n, uint8_t width, uint8_t text_width,
+                                 uint64_t ram_budget, uint64_t num_threads,
+                                 uint64_t sample_dens=0, bool sa_free=false);
+
+//! Saves the construct_config settings and restores them on destruction.
+class construct_config_guard
+{
+    private:
+        byte_sa_algo_type m_byte_algo_sa;
+        int_sa_algo_type  m_int_algo_sa;
+        lcp_algo_type     m_lcp_algo;
+        bwt_algo_type     m_bwt_algo;
+        uint64_t          m_num_threads;
+        bool              m_pipeline;
+        bool              m_wm_semi_external;
+    public:
+        construct_config_guard() : m_byte_algo_sa(construct_config::byte_algo_sa),
+            m_int_algo_sa(construct_config::int_algo_sa),
+            m_lcp_algo(construct_config::lcp_algo),
+            m_bwt_algo(construct_config::bwt_algo),
+            m_num_threads(construct_config::num_threads),
+            m_pipeline(construct_config::pipeline),
+            m_wm_semi_external(construct_config::wm_semi_external) {}
+        ~construct_config_guard() {
+            construct_config::byte_algo_sa = m_byte_algo_sa;
+            construct_config::int_algo_sa  = m_int_algo_sa;
+            construct_config::lcp_algo     = m_lcp_algo;
+            construct_config::bwt_algo     = m_bwt_algo;
+            construct_config::num_threads  = m_num_threads;
+            construct_config::pipeline     = m_pipeline;
+            construct_config::wm_semi_external = m_wm_semi_external;
+        }
+        construct_config_guard(const construct_config_guard&) = delete;
+        construct_config_guard& operator=(const construct_config_guard&) = delete;
+};
+
+//! Appends the wall-clock time of a construction stage to a list of stage times on destruction.
+/*! Used for cache_config::stage_times. Stages which run concurrently
+ *  use separate lists, which are merged after the threads are joined.
+ */
+class stage_timer
+{
+    private:
+        typedef std::chrono::steady_clock clock;
+        tVSD&             m_times;
+        std::string       m_name;
+        clock::time_point m_start;
+    public:
+        stage_timer(tVSD& times, const std::string& name) : m_times(times), m_name(name), m_start(clock::now()) {}
+        ~stage_timer() {
+            m_times.emplace_back(m_name, std::chrono::duration<double>(clock::now()-m_start).count());
+        }
+        stage_timer(const stage_timer&) = delete;
+        stage_timer& operator=(const stage_timer&) = delete;
+};
+
 }
 
 #endif
@@ -33,6 +33,8 @@
 #include "wt_huff.hpp"
 #include "wt_algorithm.hpp"
 #include "construct_lcp_helper.hpp"
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
 
 #include <iostream>
 #include <stdexcept>
@@ -181,6 +183,107 @@ void construct_lcp_PHI(cache_config& config)
 }
 
 
+template<uint8_t t_width, class t_uint>
+void _construct_lcp_PHI_parallel(cache_config& config, uint64_t n, uint64_t num_threads)
+{
+    typedef int_vector<>::size_type size_type;
+    typedef int_vector<t_width> text_type;
+    const std::string sa_file = cache_file_name(conf::KEY_SA, config);
+    size_type buffer_size = 1000000;
+
+//	(1) Calculate PHI (stored in array plcp); each thread scans its own part of SA
+    std::vector<t_uint> plcp(n, 0);
+    parallel::for_each_range(num_threads, n, [&](uint64_t, uint64_t b, uint64_t e) {
+        int_vector_buffer<> sa_buf(sa_file, std::ios::in, buffer_size);
+        size_type sai_1 = b ? sa_buf[b-1] : 0;
+        for (size_type i=b; i < e; ++i) {
+            size_type sai = sa_buf[i];
+            plcp[ sai ] = sai_1;
+            sai_1 = sai;
+        }
+    });
+
+//  (2) Load text from disk
+    text_type text;
+    load_from_cache(text, key_text_trait<t_width>::KEY_TEXT, config);
+
+//  (3) Calculate PLCP; each thread handles a range of text positions
+    std::vector<size_type> max_l(num_threads, 0);
+    parallel::for_each_range(num_threads, n-1, [&](uint64_t t, uint64_t b, uint64_t e) {
+        for (size_type i=b, l=0; i < e; ++i) {
+            size_type phii = plcp[i];
+            while (text[i+l] == text[phii+l]) {
+                ++l;
+            }
+            plcp[i] = l;
+            if (l) {
+                max_l[t] = std::max(max_l[t], l);
+                --l;
+            }
+        }
+    });
+    util::clear(text);
+    uint8_t lcp_width = bits::hi(*std::max_element(max_l.begin(), max_l.end()))+1;
+
+//	(4) Transform PLCP into LCP; ranges are multiples of 64 to not share words of lcp
+    int_vector<> lcp(n, 0, lcp_width);
+    uint64_t blocks = (n+63)/64;
+    parallel::for_each_range(num_threads, blocks, [&](uint64_t, uint64_t b, uint64_t e) {
+        int_vector_buffer<> sa_buf(sa_file, std::ios::in, buffer_size);
+        for (size_type i=std::max((size_type)1, b*64); i < std::min(n, e*64); ++i) {
+            lcp[i] = plcp[sa_buf[i]];
+        }
+    });
+    std::vector<t_uint>().swap(plcp);
+    store_to_cache(lcp, conf::KEY_LCP, config);
+}
+
+//! Construct the LCP array for text over byte- or integer-alphabet with several threads.
+/*!	The algorithm computes the lcp array and stores it to disk.
+ *  \pre Text and Suffix array exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8  or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *  \post LCP array exist in the cache. Key
+ *         * conf::KEY_LCP
+ *  \par Time complexity
+ *         \f$ \Order{n/p + p\cdot\max lcp} \f$ for \f$p\f$ threads
+ *  \par Space complexity
+ *         \f$ n( \log \sigma + \log n ) \f$ bits, where \f$ \log n \f$ is
+ *         rounded to 32 or 64, plus the LCP array.
+ *
+ *  The PHI and the PLCP array are computed like in construct_lcp_PHI,
+ *  but SA and text are split into construct_config::num_threads ranges
+ *  which are processed concurrently. Each thread starts the PLCP scan
+ *  of its range with \f$ l=0 \f$.
+ *  \par Reference
+ *         Juha Kärkkäinen, Giovanni Manzini, Simon J. Puglisi:
+ *         Permuted Longest-Common-Prefix Array.
+ *         CPM 2009: 181-192
+ */
+template<uint8_t t_width>
+void construct_lcp_PHI_parallel(cache_config& config)
+{
+    static_assert(t_width == 0 or t_width == 8 , "construct_lcp_PHI_parallel: width must be `0` for integer alphabet and `8` for byte alphabet");
+    uint64_t n = 0;
+    {
+        int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+        n = sa_buf.size();
+    }
+    assert(n > 0);
+    if (1 == n) {  // Handle special case: Input only the sentinel character.
+        int_vector<> lcp(1, 0);
+        store_to_cache(lcp, conf::KEY_LCP, config);
+        return;
+    }
+    uint64_t num_threads = parallel::threads_for(construct_config::num_threads, n, 1<<16);
+    if (n <= 0xFFFFFFFFULL) {
+        _construct_lcp_PHI_parallel<t_width, uint32_t>(config, n, num_threads);
+    } else {
+        _construct_lcp_PHI_parallel<t_width, uint64_t>(config, n, num_threads);
+    }
+}
+
+
 //! Construct the LCP array (only for byte strings)
 /*!	The algorithm computes the lcp array and stores it to disk.
  *  \param config	Reference to cache configuration
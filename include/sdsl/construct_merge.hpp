@@ -0,0 +1,208 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file construct_merge.hpp
+    \brief construct_merge.hpp contains methods to construct the CSA of a
+           concatenation by merging the BWT of an existing CSA with the
+           suffixes of a new text.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_MERGE
+#define INCLUDED_SDSL_CONSTRUCT_MERGE
+
+#include "sdsl_concepts.hpp"
+#include "int_vector.hpp"
+#include "construct.hpp"
+#include "construct_sa_parallel.hpp"
+#include "suffix_array_algorithm.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Constructs the CSA of the concatenation of a text and the text of an existing CSA.
+/*!
+ * \param csa      The resulting CSA of \f$T_{new} T_{old}\f$.
+ * \param text     The new text \f$T_{new}\f$ (without a 0-symbol).
+ * \param csa_old  The CSA of \f$T_{old}\f$.
+ * \param config   Cache configuration for the BWT and the samples of the result.
+ *
+ * The suffixes of \f$T_{old}\f$ are also suffixes of the concatenation, so
+ * their order is kept. For each suffix of the new text the number of smaller
+ * old suffixes is computed by backward search on csa_old. These counts
+ * together with the first symbol reduce the sorting of the new suffixes to
+ * the suffix sorting of a string of length \f$|T_{new}|\f$. Afterwards the
+ * BWT of the concatenation is obtained by merging, and the samples are
+ * computed by construct_sa_samples.
+ *
+ * \par Time complexity
+ *      \f$ \Order{|T_{new}| (t_{rank\_bwt} + \log |T_{new}|) + n (t_{bwt} + t_{LF})} \f$,
+ *      the SA of \f$T_{old}\f$ is not constructed again.
+ * \pre The samplings of t_csa can be built from the SA samples (see sa_samples_trait)
+ *      and neither KEY_SA nor KEY_BWT is cached for config.
+ */
+template<class t_csa>
+void construct_merge(t_csa& csa, const int_vector<8>& text, const t_csa& csa_old, cache_config& config)
+{
+    static_assert(t_csa::alphabet_category::WIDTH == 8, "construct_merge: only byte alphabets are supported");
+    static_assert(sa_samples_trait<typename t_csa::sa_sample_type>::value
+                  and sa_samples_trait<typename t_csa::isa_sample_type>::value,
+                  "construct_merge: the samplings have to support construction from SA samples");
+    typedef typename t_csa::size_type size_type;
+    auto event = memory_monitor::event("merge CSA");
+    if (cache_file_exists(conf::KEY_SA, config) or cache_file_exists(conf::KEY_BWT, config)) {
+        throw std::logic_error("construct_merge: SA or BWT of another text is cached for config");
+    }
+    for (size_type i=0; i < text.size(); ++i) {
+        if (text[i] == 0) {
+            throw std::logic_error("construct_merge: text contains zero symbol");
+        }
+    }
+    const size_type m = text.size();
+    const size_type n_old = csa_old.size();
+    const size_type row0 = csa_old.isa[0]; // row of T_old
+
+    // (1) Number of suffixes of T_old which are smaller than T_new[i..]T_old
+    std::vector<size_type> lt(257, 0);    // number of old suffixes starting with a symbol < c
+    for (size_type c=0, cc=0; c < 256; ++c) {
+        while (cc < csa_old.sigma and csa_old.comp2char[cc] < c) {
+            ++cc;
+        }
+        lt[c] = csa_old.C[cc];
+    }
+    lt[256] = n_old;
+    int_vector<> r(m, 0, bits::hi(n_old)+1);
+    {
+        auto event = memory_monitor::event("backward search new suffixes");
+        size_type p = row0;
+        for (size_type i=m; i > 0; --i) {
+            uint8_t c = text[i-1];
+            bool occ = csa_old.comp2char[csa_old.char2comp[c]] == c;
+            p = lt[c] + (occ ? csa_old.bwt.rank(p, c) : 0);
+            r[i-1] = p;
+        }
+    }
+
+    // (2) Sort the new suffixes. T_new[i..]T_old < T_new[j..]T_old iff
+    //     (r[i],T_new[i], r[i+1],T_new[i+1], ...) is smaller, where the sequence of
+    //     T_new[i..] ends with the rank of T_old itself, which lies between r-values.
+    int_vector<> new_sa;
+    {
+        auto event = memory_monitor::event("sort new suffixes");
+        std::vector<uint64_t> keys(m+1);
+        for (size_type i=0; i < m; ++i) {
+            keys[i] = ((2*(uint64_t)r[i])<<8) | text[i];
+        }
+        keys[m] = (2*(uint64_t)row0+1)<<8;
+        std::vector<uint64_t> alphabet(keys);
+        std::sort(alphabet.begin(), alphabet.end());
+        alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+        int_vector<> key_text(m+2, 0, bits::hi(alphabet.size())+1);
+        for (size_type i=0; i <= m; ++i) {
+            key_text[i] = std::lower_bound(alphabet.begin(), alphabet.end(), keys[i])-alphabet.begin()+1;
+        }
+        std::vector<uint64_t>().swap(keys);
+        std::vector<uint64_t>().swap(alphabet);
+        int_vector<> sa;
+        parallel_doubling::construct_sa(sa, key_text, construct_config::num_threads);
+        new_sa = int_vector<>(m, 0, bits::hi(std::max(m, (size_type)1))+1);
+        for (size_type i=0, j=0; i < sa.size(); ++i) {
+            if (sa[i] < m) {
+                new_sa[j++] = sa[i];
+            }
+        }
+    }
+
+    // (3) Merge the BWT of T_old with the symbols preceding the new suffixes
+    {
+        auto event = memory_monitor::event("merge BWT");
+        int_vector_buffer<8> bwt_buf(cache_file_name(conf::KEY_BWT, config), std::ios::out);
+        size_type pos = 0, j = 0;
+        auto add_new = [&](size_type q) {
+            for (; j < m and r[new_sa[j]] == q; ++j) {
+                bwt_buf[pos++] = new_sa[j] > 0 ? text[new_sa[j]-1] : 0;
+            }
+        };
+        for (size_type q=0; q < n_old; ++q) {
+            add_new(q);
+            bwt_buf[pos++] = q == row0 and m > 0 ? text[m-1] : csa_old.bwt[q];
+        }
+        add_new(n_old);
+        bwt_buf.close();
+        register_cache_file(conf::KEY_BWT, config);
+    }
+    util::clear(r);
+    util::clear(new_sa);
+
+    // (4) Build the CSA from the merged BWT
+    {
+        auto event = memory_monitor::event("SA samples");
+        construct_sa_samples(config, t_csa::sa_sample_dens, t_csa::isa_sample_dens);
+    }
+    {
+        auto event = memory_monitor::event("construct CSA");
+        t_csa tmp(config);
+        csa.swap(tmp);
+    }
+    if (config.delete_files) {
+        auto event = memory_monitor::event("delete temporary files");
+        util::delete_all_files(config.file_map);
+    }
+}
+
+//! Constructs the CSA of the concatenation of a text file and the text of an existing CSA.
+/*!
+ * \param csa       The resulting CSA.
+ * \param file      Name of the new text file.
+ * \param csa_old   The CSA of the existing text, which will follow the new text.
+ * \param config    Cache configuration.
+ * \param num_bytes Format of the file (see construct).
+ */
+template<class t_csa>
+void construct_merge(t_csa& csa, const std::string& file, const t_csa& csa_old, cache_config& config, uint8_t num_bytes=1)
+{
+    int_vector<8> text;
+    load_vector_from_file(text, file, num_bytes);
+    construct_merge(csa, text, csa_old, config);
+}
+
+//! Constructs the CSA of the concatenation of the texts of two CSAs.
+/*!
+ * \param csa       The resulting CSA of \f$T_1 T_2\f$, where the 0-symbol of \f$T_1\f$ is removed.
+ * \param csa1      The CSA of \f$T_1\f$, whose text is extracted.
+ * \param csa2      The CSA of \f$T_2\f$, whose BWT is merged.
+ * \param config    Cache configuration.
+ *
+ * The time is dominated by the extraction of \f$T_1\f$ and the scan over the BWT of csa2,
+ * so csa1 should be the CSA of the smaller text.
+ */
+template<class t_csa>
+void construct_merge(t_csa& csa, const t_csa& csa1, const t_csa& csa2, cache_config& config)
+{
+    int_vector<8> text;
+    if (csa1.size() > 1) {
+        auto str = extract(csa1, 0, csa1.size()-2);
+        text.resize(str.size());
+        std::copy(str.begin(), str.end(), text.begin());
+    }
+    construct_merge(csa, text, csa2, config);
+}
+
+} // end namespace sdsl
+
+#endif
@@ -31,6 +31,7 @@
 #include "qsufsort.hpp"
 
 #include "construct_sa_se.hpp"
+#include "construct_sa_parallel.hpp"
 #include "construct_config.hpp"
 
 namespace sdsl
@@ -60,6 +61,27 @@ namespace sdsl
  */
 void construct_sa_se(cache_config& config);
 
+//! Constructs the Suffix Array (SA) from text over integer-alphabet.
+/*! The algorithm constructs the SA and stores it to disk.
+ *  \param config Reference to cache configuration
+ *  \par Time complexity
+ *       \f$ O(n) \f$ independent of the alphabet size \f$\sigma\f$.
+ *  \par Space complexity
+ *       The induced sorting needs random access to the text, so the text
+ *       is held in main memory with \f$\lceil\log\sigma\rceil\f$ bits
+ *       per symbol. The SA is written to disk and the remaining arrays are
+ *       streamed, which adds about \f$\frac{n}{2}\log n\f$ bits for the
+ *       reduced problem.
+ *  \pre Text exist in the cache. Keys:
+ *         * conf::KEY_TEXT_INT
+ *  \post SA exist in the cache. Key
+ *         * conf::KEY_SA
+ *
+ *  Uses the SAIS implementation of construct_sa_se for
+ *  integer alphabets.
+ */
+void construct_sa_sais_int(cache_config& config);
+
 namespace algorithm
 {
 
@@ -139,8 +161,13 @@ void calculate_sa(const unsigned char* c, typename int_vector<fixedIntWidth>::si
  *  \post SA exist in the cache. Key
  *         * conf::KEY_SA
  *  \par Reference
- *    For t_width=8: DivSufSort (http://code.google.com/p/libdivsufsort/)
- *    For t_width=0: qsufsort (http://www.larsson.dogma.net/qsufsort.c)
+ *    For t_width=8: DivSufSort (http://code.google.com/p/libdivsufsort/),
+ *                   seSAIS or parallel prefix doubling depending on
+ *                   construct_config::byte_algo_sa. The latter uses
+ *                   construct_config::num_threads threads.
+ *    For t_width=0: qsufsort (http://www.larsson.dogma.net/qsufsort.c),
+ *                   SAIS or parallel prefix doubling depending on
+ *                   construct_config::int_algo_sa.
  */
 template<uint8_t t_width>
 void construct_sa(cache_config& config)
@@ -158,12 +185,28 @@ void construct_sa(cache_config& config)
             store_to_cache(sa, conf::KEY_SA, config);
         } else if (construct_config::byte_algo_sa == SE_SAIS) {
             construct_sa_se(config);
+        } else if (construct_config::byte_algo_sa == PARALLEL_DOUBLING) {
+            int_vector<t_width> text;
+            load_from_cache(text, KEY_TEXT, config);
+            int_vector<> sa;
+            parallel_doubling::construct_sa(sa, text, construct_config::num_threads);
+            store_to_cache(sa, conf::KEY_SA, config);
         }
     } else if (t_width == 0) {
-        // call qsufsort
-        int_vector<> sa;
-        sdsl::qsufsort::construct_sa(sa, cache_file_name(KEY_TEXT, config).c_str(), 0);
-        store_to_cache(sa, conf::KEY_SA, config);
+        if (construct_config::int_algo_sa == QSUFSORT) {
+            // call qsufsort
+            int_vector<> sa;
+            sdsl::qsufsort::construct_sa(sa, cache_file_name(KEY_TEXT, config).c_str(), 0);
+            store_to_cache(sa, conf::KEY_SA, config);
+        } else if (construct_config::int_algo_sa == SAIS_INT) {
+            construct_sa_sais_int(config);
+        } else if (construct_config::int_algo_sa == PARALLEL_DOUBLING_INT) {
+            int_vector<> text;
+            load_from_cache(text, KEY_TEXT, config);
+            int_vector<> sa;
+            parallel_doubling::construct_sa(sa, text, construct_config::num_threads);
+            store_to_cache(sa, conf::KEY_SA, config);
+        }
     } else {
         std::cerr << "Unknown alphabet type" << std::endl;
     }
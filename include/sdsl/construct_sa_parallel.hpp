@@ -0,0 +1,200 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file construct_sa_parallel.hpp
+    \brief construct_sa_parallel.hpp contains a multi-threaded prefix doubling
+           suffix array construction algorithm.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_SA_PARALLEL
+#define INCLUDED_SDSL_CONSTRUCT_SA_PARALLEL
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "parallel_helper.hpp"
+#include <vector>
+#include <utility>
+
+namespace sdsl
+{
+namespace parallel_doubling
+{
+
+typedef std::vector<std::pair<uint64_t,uint64_t>> group_list_type;
+
+//! Construct a suffix array for a text using prefix doubling on several threads.
+/*!
+ * \param sa          A reference to the resulting suffix array.
+ * \param text        The text. The last symbol has to be a unique 0-symbol.
+ * \param num_threads Number of threads used during the construction.
+ *
+ * The suffixes are first sorted according to their first \f$q\f$ symbols,
+ * where \f$q\f$ symbols fit into a 64-bit word. Afterwards all groups of
+ * suffixes with equal prefixes of length \f$h\f$ are refined in rounds
+ * according to the rank of suffix \f$SA[i]+h\f$ (Larsson and Sadakane).
+ * The groups of one round are independent and therefore processed
+ * concurrently.
+ *
+ * \par Space complexity
+ *      \f$ 16n \f$ bytes for SA and ISA plus the list of unsorted groups.
+ */
+template<class t_text>
+void construct_sa(int_vector<>& sa, const t_text& text, uint64_t num_threads)
+{
+    const uint64_t n = text.size();
+    sa = int_vector<>(n, 0, 64);
+    if (n <= 1) {
+        util::bit_compress(sa);
+        return;
+    }
+    num_threads = parallel::threads_for(num_threads, n, 1<<12);
+    int_vector<64> isa(n, 0);
+    uint64_t* SA  = sa.data();
+    uint64_t* ISA = isa.data();
+
+    // Determine how many symbols fit into one 64-bit word
+    std::vector<uint64_t> max_sym(num_threads, 0);
+    parallel::for_each_range(num_threads, n, [&](uint64_t t, uint64_t b, uint64_t e) {
+        for (uint64_t i=b; i<e; ++i) {
+            max_sym[t] = std::max(max_sym[t], (uint64_t)text[i]);
+        }
+    });
+    const uint8_t w = bits::hi(std::max((uint64_t)1, *std::max_element(max_sym.begin(), max_sym.end())))+1;
+    const uint64_t q = 64/w;
+    auto key = [&](uint64_t i) {
+        uint64_t k = 0;
+        for (uint64_t j=0; j<q; ++j) {
+            k <<= w;
+            if (i+j < n) {
+                k |= (uint64_t)text[i+j];
+            }
+        }
+        return k;
+    };
+
+    // Sort suffixes according to the first q symbols
+    parallel::for_each_range(num_threads, n, [&](uint64_t, uint64_t b, uint64_t e) {
+        for (uint64_t i=b; i<e; ++i) {
+            SA[i] = i;
+        }
+    });
+    parallel::sort(SA, SA+n, [&](uint64_t a, uint64_t b) {
+        return key(a) < key(b);
+    }, num_threads);
+
+    // Each thread processes the groups which start in its range of SA.
+    // Group numbers are the rightmost position of the group in SA.
+    std::vector<group_list_type> local(num_threads);
+    parallel::for_each_range(num_threads, n, [&](uint64_t t, uint64_t b, uint64_t e) {
+        uint64_t i = b;
+        while (i > 0 and i < e and key(SA[i-1]) == key(SA[i])) {
+            ++i;
+        }
+        while (i < e) {
+            uint64_t k = key(SA[i]);
+            uint64_t j = i+1;
+            while (j < n and key(SA[j]) == k) {
+                ++j;
+            }
+            for (uint64_t l=i; l<j; ++l) {
+                ISA[SA[l]] = j-1;
+            }
+            if (j-i > 1) {
+                local[t].emplace_back(i, j);
+            }
+            i = j;
+        }
+    });
+    group_list_type groups;
+    for (auto& l : local) {
+        groups.insert(groups.end(), l.begin(), l.end());
+        group_list_type().swap(l);
+    }
+
+    // Refine unsorted groups until all groups are singletons
+    for (uint64_t h=q; !groups.empty(); h*=2) {
+        auto rank = [&](uint64_t i) {
+            return i+h < n ? ISA[i+h]+1 : 0;
+        };
+        auto comp = [&](uint64_t a, uint64_t b) {
+            return rank(a) < rank(b);
+        };
+        // Assign groups to threads such that each thread gets about the same number of suffixes
+        uint64_t total = 0;
+        for (auto& g : groups) {
+            total += g.second-g.first;
+        }
+        uint64_t threads = parallel::threads_for(num_threads, total, 1<<12);
+        uint64_t chunk = (total+threads-1)/threads;
+        std::vector<uint64_t> bounds(1, 0);
+        for (uint64_t g=0, sum=0; g < groups.size(); ++g) {
+            uint64_t size = groups[g].second-groups[g].first;
+            if (size > chunk) { // large groups are sorted by all threads
+                parallel::sort(SA+groups[g].first, SA+groups[g].second, comp, threads);
+            }
+            sum += size;
+            if (sum >= chunk*bounds.size() and bounds.size() < threads) {
+                bounds.push_back(g+1);
+            }
+        }
+        while (bounds.size() <= threads) {
+            bounds.push_back(groups.size());
+        }
+        // Phase 1: sort groups and determine subgroups; ISA is only read
+        parallel::run(threads, [&](uint64_t t) {
+            local[t].clear();
+            for (uint64_t g=bounds[t]; g < bounds[t+1]; ++g) {
+                uint64_t b = groups[g].first, e = groups[g].second;
+                if (e-b <= chunk) {
+                    std::sort(SA+b, SA+e, comp);
+                }
+                for (uint64_t i=b; i<e;) {
+                    uint64_t r = rank(SA[i]);
+                    uint64_t j = i+1;
+                    while (j < e and rank(SA[j]) == r) {
+                        ++j;
+                    }
+                    local[t].emplace_back(i, j);
+                    i = j;
+                }
+            }
+        });
+        // Phase 2: update group numbers
+        parallel::run(threads, [&](uint64_t t) {
+            group_list_type unsorted;
+            for (auto& g : local[t]) {
+                for (uint64_t i=g.first; i<g.second; ++i) {
+                    ISA[SA[i]] = g.second-1;
+                }
+                if (g.second-g.first > 1) {
+                    unsorted.push_back(g);
+                }
+            }
+            local[t].swap(unsorted);
+        });
+        groups.clear();
+        for (uint64_t t=0; t<threads; ++t) {
+            groups.insert(groups.end(), local[t].begin(), local[t].end());
+        }
+    }
+    util::clear(isa);
+    util::bit_compress(sa);
+}
+
+} // end namespace parallel_doubling
+} // end namespace sdsl
+
+#endif
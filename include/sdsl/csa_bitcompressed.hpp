@@ -28,6 +28,7 @@
 #include "util.hpp"
 #include "csa_sampling_strategy.hpp"
 #include "csa_alphabet_strategy.hpp"
+#include "kmer_table.hpp"
 #include <iostream>
 #include <algorithm>
 #include <string>
@@ -48,13 +49,15 @@ namespace sdsl
  * why it is in the group of compressed suffix arrays.
  *
  *  \tparam t_alphabet_strat  Policy for alphabet representation.
+ *  \tparam t_kmer_table      Table of the SA intervals of short strings, which
+ *                            speeds up the first backward search steps.
  *
  * \par Space complexity
  *        \f$ 2n\cdot \log n\f$ bits, where \f$n\f$ equals the \f$size()\f$ of the suffix array.
  * \sa sdsl::csa_sada, sdsl::csa_wt
  * @ingroup csa
  */
-template<class t_alphabet_strat=byte_alphabet>
+template<class t_alphabet_strat=byte_alphabet, class t_kmer_table=kmer_table<>>
 class csa_bitcompressed
 {
         friend class bwt_of_csa_psi<csa_bitcompressed>;
@@ -78,6 +81,7 @@ class csa_bitcompressed
         typedef _isa_sampling<csa_bitcompressed,0>              isa_sample_type;
         typedef isa_sample_type                                 isa_type;
         typedef t_alphabet_strat                                alphabet_type;
+        typedef t_kmer_table                                    kmer_table_type;
         typedef typename alphabet_type::char_type               char_type; // Note: This is the char type of the CSA not the WT!
         typedef typename alphabet_type::comp_char_type          comp_char_type;
         typedef typename alphabet_type::string_type             string_type;
@@ -95,12 +99,14 @@ class csa_bitcompressed
         sa_sample_type  m_sa;  // vector for suffix array values
         isa_sample_type m_isa; // vector for inverse suffix array values
         alphabet_type   m_alphabet;
+        kmer_table_type m_kmers; // SA intervals of short strings
 
         void copy(const csa_bitcompressed& csa)
         {
             m_sa       = csa.m_sa;
             m_isa      = csa.m_isa;
             m_alphabet = csa.m_alphabet;
+            m_kmers    = csa.m_kmers;
         }
     public:
         const typename alphabet_type::char2comp_type& char2comp  = m_alphabet.char2comp;
@@ -116,6 +122,7 @@ class csa_bitcompressed
         const text_type                               text       = text_type(*this);
         const sa_sample_type&                         sa_sample  = m_sa;
         const isa_sample_type&                        isa_sample = m_isa;
+        const kmer_table_type&                        kmers      = m_kmers;
 
         //! Default constructor
         csa_bitcompressed() {}
@@ -149,6 +156,10 @@ class csa_bitcompressed
                 isa_sample_type tmp_sample(config);
                 m_isa.swap(tmp_sample);
             }
+            if (kmer_table_type::max_k > 0) {
+                kmer_table_type tmp_kmers(*this, config.kmer_table_budget);
+                m_kmers.swap(tmp_kmers);
+            }
         }
 
 
@@ -186,6 +197,7 @@ class csa_bitcompressed
                 m_sa.swap(csa.m_sa);
                 m_isa.swap(csa.m_isa);
                 m_alphabet.swap(csa.m_alphabet);
+                m_kmers.swap(csa.m_kmers);
             }
         }
 
@@ -239,6 +251,7 @@ class csa_bitcompressed
                 m_sa       = std::move(csa.m_sa);
                 m_isa      = std::move(csa.m_isa);
                 m_alphabet = std::move(csa.m_alphabet);
+                m_kmers    = std::move(csa.m_kmers);
             }
             return *this;
         }
@@ -254,6 +267,7 @@ class csa_bitcompressed
             written_bytes += m_sa.serialize(out, child, "m_sa");
             written_bytes += m_isa.serialize(out, child, "m_isa");
             written_bytes += m_alphabet.serialize(out, child, "m_alphabet");
+            written_bytes += m_kmers.serialize(out, child, "m_kmers");
             structure_tree::add_size(child, written_bytes);
             return written_bytes;
         }
@@ -263,6 +277,7 @@ class csa_bitcompressed
             m_sa.load(in);
             m_isa.load(in);
             m_alphabet.load(in);
+            m_kmers.load(in);
         }
 
         size_type get_sample_dens()const
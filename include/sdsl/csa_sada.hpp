@@ -28,6 +28,9 @@
 #include "util.hpp"
 #include "csa_sampling_strategy.hpp"
 #include "csa_alphabet_strategy.hpp"
+#include "kmer_table.hpp"
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cassert>
@@ -46,6 +49,8 @@ namespace sdsl
   *  \tparam t_sa_sample_strat Policy of SA sampling. E.g. sample in SA-order or text-order.
   *  \tparam t_isa             Vector type for ISA sample values.
   *  \tparam t_alphabet_strat  Policy for alphabet representation.
+  *  \tparam t_kmer_table      Table of the SA intervals of short strings, which
+  *                            speeds up the first backward search steps.
   *
   *  \sa sdsl::csa_wt, sdsl::csa_bitcompressed
   * @ingroup csa
@@ -55,7 +60,8 @@ template<class t_enc_vec         = enc_vector<>,          // Vector type used to
          uint32_t t_inv_dens     = 64,                    // Sample density for inverse suffix array (ISA) values
          class t_sa_sample_strat = sa_order_sa_sampling<>,// Policy class for the SA sampling.
          class t_isa_sample_strat= isa_sampling<>,        // Policy class for ISA sampling.
-         class t_alphabet_strat  = byte_alphabet          // Policy class for the representation of the alphabet.
+         class t_alphabet_strat  = byte_alphabet,         // Policy class for the representation of the alphabet.
+         class t_kmer_table      = kmer_table<>           // Table of SA intervals of all strings of length k.
          >
 class csa_sada
 {
@@ -98,6 +104,7 @@ class csa_sada
         typedef typename t_sa_sample_strat::template type<csa_sada>  sa_sample_type;
         typedef typename t_isa_sample_strat::template type<csa_sada> isa_sample_type;
         typedef t_alphabet_strat                                     alphabet_type;
+        typedef t_kmer_table                                         kmer_table_type;
         typedef typename alphabet_type::alphabet_category            alphabet_category;
         typedef typename alphabet_type::comp_char_type               comp_char_type;
         typedef typename alphabet_type::char_type                    char_type; // Note: This is the char type of the CSA not the WT!
@@ -116,8 +123,7 @@ class csa_sada
         sa_sample_type  m_sa_sample;  // suffix array samples
         isa_sample_type m_isa_sample; // inverse suffix array samples
         alphabet_type   m_alphabet;   // alphabet component
-
-        mutable std::vector<uint64_t> m_psi_buf; // buffer for decoded psi values
+        kmer_table_type m_kmers;      // SA intervals of short strings
 
         void copy(const csa_sada& csa)
         {
@@ -126,15 +132,9 @@ class csa_sada
             m_isa_sample = csa.m_isa_sample;
             m_isa_sample.set_vector(&m_sa_sample);
             m_alphabet   = csa.m_alphabet;
+            m_kmers      = csa.m_kmers;
         };
 
-        void create_buffer()
-        {
-            if (enc_vector_type::sample_dens < linear_decode_limit) {
-                m_psi_buf = std::vector<uint64_t>(enc_vector_type::sample_dens+1);
-            }
-        }
-
     public:
         const typename alphabet_type::char2comp_type& char2comp  = m_alphabet.char2comp;
         const typename alphabet_type::comp2char_type& comp2char  = m_alphabet.comp2char;
@@ -149,20 +149,17 @@ class csa_sada
         const text_type                               text       = text_type(*this);
         const sa_sample_type&                         sa_sample  = m_sa_sample;
         const isa_sample_type&                        isa_sample = m_isa_sample;
+        const kmer_table_type&                        kmers      = m_kmers;
 
 
         //! Default Constructor
-        csa_sada()
-        {
-            create_buffer();
-        }
+        csa_sada() { }
         //! Default Destructor
         ~csa_sada() { }
 
         //! Copy constructor
         csa_sada(const csa_sada& csa)
         {
-            create_buffer();
             copy(csa);
         }
 
@@ -264,7 +261,7 @@ class csa_sada
                 m_sa_sample  = std::move(csa.m_sa_sample);
                 m_isa_sample = std::move(csa.m_isa_sample);
                 m_alphabet   = std::move(csa.m_alphabet);
-                m_psi_buf    = std::move(csa.m_psi_buf);
+                m_kmers      = std::move(csa.m_kmers);
             }
             return *this;
         }
@@ -323,24 +320,28 @@ class csa_sada
 // TODO: don't use get_inter_sampled_values if t_dens is really
 //       large
                 lower_b = lower_sb*sd;
-                if (0 == m_psi_buf.size()) {
+                if (enc_vector_type::sample_dens >= linear_decode_limit) {
                     upper_b = std::min(upper_sb*sd, C[cc+1]);
                     goto finish;
                 }
-                uint64_t* p = m_psi_buf.data();
+                // buffer for decoded psi values; one per thread, so that
+                // concurrent queries on the same object are safe
+                static thread_local std::vector<uint64_t> psi_buf;
+                psi_buf.resize(enc_vector_type::sample_dens+1);
+                uint64_t* p = psi_buf.data();
                 // extract the psi values between two samples
                 m_psi.get_inter_sampled_values(lower_sb, p);
-                p = m_psi_buf.data();
+                p = psi_buf.data();
                 uint64_t smpl = m_psi.sample(lower_sb);
                 // handle border cases
                 if (lower_b + m_psi.get_sample_dens() >= C[cc+1])
-                    m_psi_buf[ C[cc+1]-lower_b ] = size()-smpl;
+                    psi_buf[ C[cc+1]-lower_b ] = size()-smpl;
                 else
-                    m_psi_buf[ m_psi.get_sample_dens() ] = size()-smpl;
+                    psi_buf[ m_psi.get_sample_dens() ] = size()-smpl;
                 // search the result linear
                 while ((*p++)+smpl < i);
 
-                return p-1-m_psi_buf.data() + lower_b - C[cc];
+                return p-1-psi_buf.data() + lower_b - C[cc];
             } else { // lower_b == (m_C[cc]+sd-1)/sd and lower_sb < upper_sb
                 if (m_psi.sample(lower_sb) >= i) {
                     lower_b = C[cc];
@@ -391,58 +392,91 @@ finish:
 
 // == template functions ==
 
-template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::csa_sada(cache_config& config)
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::csa_sada(cache_config& config)
 {
-    create_buffer();
     if (!cache_file_exists(key_trait<alphabet_type::int_width>::KEY_BWT, config)) {
         return;
     }
-    int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
-    size_type n = bwt_buf.size();
-    {
-        auto event = memory_monitor::event("construct csa-alpbabet");
-        alphabet_type tmp_alphabet(bwt_buf, n);
-        m_alphabet.swap(tmp_alphabet);
-    }
+    // PSI depends only on the BWT and the samples only on the SA,
+    // so both can be built concurrently. The samples use a copy of config.
+    cache_config sample_config = config;
+    sample_config.stage_times.clear();
+    auto construct_psi = [&]() {
+        int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
+        size_type n = bwt_buf.size();
+        {
+            stage_timer timer(config.stage_times, "construct csa-alphabet");
+            alphabet_type tmp_alphabet(bwt_buf, n);
+            m_alphabet.swap(tmp_alphabet);
+        }
 
-    int_vector<> cnt_chr(sigma, 0, bits::hi(n)+1);
-    for (typename alphabet_type::sigma_type i=0; i < sigma; ++i) {
-        cnt_chr[i] = C[i];
-    }
-    // calculate psi
-    {
-        auto event = memory_monitor::event("construct PSI");
-        // TODO: move PSI construct into construct_PSI.hpp
-        int_vector<> psi(n, 0, bits::hi(n)+1);
-        for (size_type i=0; i < n; ++i) {
-            psi[ cnt_chr[ char2comp[bwt_buf[i]] ]++ ] = i;
+        int_vector<> cnt_chr(sigma, 0, bits::hi(n)+1);
+        for (typename alphabet_type::sigma_type i=0; i < sigma; ++i) {
+            cnt_chr[i] = C[i];
         }
-        std::string psi_file = cache_file_name(conf::KEY_PSI, config);
-        if (!store_to_cache(psi, conf::KEY_PSI, config)) {
-            return;
+        // calculate psi
+        {
+            stage_timer timer(config.stage_times, "construct PSI");
+            // TODO: move PSI construct into construct_PSI.hpp
+            int_vector<> psi(n, 0, bits::hi(n)+1);
+            for (size_type i=0; i < n; ++i) {
+                psi[ cnt_chr[ char2comp[bwt_buf[i]] ]++ ] = i;
+            }
+            std::string psi_file = cache_file_name(conf::KEY_PSI, config);
+            if (!store_to_cache(psi, conf::KEY_PSI, config)) {
+                return;
+            }
+        }
+        {
+            stage_timer timer(config.stage_times, "encode PSI");
+            int_vector_buffer<> psi_buf(cache_file_name(conf::KEY_PSI, config));
+            t_enc_vec tmp_psi(psi_buf);
+            m_psi.swap(tmp_psi);
+        }
+    };
+    auto construct_samples = [&]() {
+        {
+            stage_timer timer(sample_config.stage_times, "sample SA");
+            sa_sample_type tmp_sa_sample(sample_config);
+            m_sa_sample.swap(tmp_sa_sample);
+        }
+        {
+            stage_timer timer(sample_config.stage_times, "sample ISA");
+            isa_sample_type isa_s(sample_config, &m_sa_sample);
+            util::swap_support(m_isa_sample, isa_s, &m_sa_sample, (const sa_sample_type*)nullptr);
+        }
+    };
+    if (construct_config::pipeline and construct_config::num_threads > 1) {
+        auto event = memory_monitor::event("construct PSI and sample SA/ISA");
+        parallel::run(2, [&](uint64_t t) {
+            if (t == 0) {
+                construct_psi();
+            } else {
+                construct_samples();
+            }
+        });
+    } else {
+        {
+            auto event = memory_monitor::event("construct PSI");
+            construct_psi();
+        }
+        {
+            auto event = memory_monitor::event("sample SA/ISA");
+            construct_samples();
         }
     }
-    {
-        auto event = memory_monitor::event("encode PSI");
-        int_vector_buffer<> psi_buf(cache_file_name(conf::KEY_PSI, config));
-        t_enc_vec tmp_psi(psi_buf);
-        m_psi.swap(tmp_psi);
-    }
-    {
-        auto event = memory_monitor::event("sample SA");
-        sa_sample_type tmp_sa_sample(config);
-        m_sa_sample.swap(tmp_sa_sample);
-    }
-    {
-        auto event = memory_monitor::event("sample ISA");
-        isa_sample_type isa_s(config, &m_sa_sample);
-        util::swap_support(m_isa_sample, isa_s, &m_sa_sample, (const sa_sample_type*)nullptr);
+    config.stage_times.insert(config.stage_times.end(), sample_config.stage_times.begin(), sample_config.stage_times.end());
+    config.file_map.insert(sample_config.file_map.begin(), sample_config.file_map.end());
+    if (kmer_table_type::max_k > 0) {
+        stage_timer timer(config.stage_times, "construct k-mer table");
+        kmer_table_type tmp_kmers(*this, config.kmer_table_budget);
+        m_kmers.swap(tmp_kmers);
     }
 }
 
-template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-inline auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::operator[](size_type i)const -> value_type
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+inline auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::operator[](size_type i)const -> value_type
 {
     size_type off = 0;
     while (!m_sa_sample.is_sampled(i)) {  // while i mod t_dens != 0 (SA[i] is not sampled)
@@ -457,8 +491,8 @@ inline auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_
 }
 
 
-template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const -> size_type
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const -> size_type
 {
     structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
     size_type written_bytes = 0;
@@ -466,27 +500,30 @@ auto csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabe
     written_bytes += m_sa_sample.serialize(out, child, "sa_samples");
     written_bytes += m_isa_sample.serialize(out, child, "isa_samples");
     written_bytes += m_alphabet.serialize(out, child, "alphabet");
+    written_bytes += m_kmers.serialize(out, child, "kmers");
     structure_tree::add_size(child, written_bytes);
     return written_bytes;
 }
 
-template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::load(std::istream& in)
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::load(std::istream& in)
 {
     m_psi.load(in);
     m_sa_sample.load(in);
     m_isa_sample.load(in, &m_sa_sample);
     m_alphabet.load(in);
+    m_kmers.load(in);
 }
 
-template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::swap(csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa)
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::swap(csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa)
 {
     if (this != &csa) {
         m_psi.swap(csa.m_psi);
         m_sa_sample.swap(csa.m_sa_sample);
         util::swap_support(m_isa_sample, csa.m_isa_sample, &m_sa_sample, &(csa.m_sa_sample));
         m_alphabet.swap(csa.m_alphabet);
+        m_kmers.swap(csa.m_kmers);
     }
 }
 
@@ -54,6 +54,7 @@
 #include "int_vector.hpp"
 #include "csa_alphabet_strategy.hpp" // for key_trait
 #include "inv_perm_support.hpp"
+#include "construct_bwt.hpp" // for sa_samples_buffer
 #include "wavelet_trees.hpp"
 #include <set>
 #include <tuple>
@@ -77,24 +78,19 @@ class _sa_order_sampling : public int_vector<t_width>
 
         //! Constructor
         /*
-         * \param cconfig Cache configuration (SA is expected to be cached.).
+         * \param cconfig Cache configuration (SA or SA samples are expected to be cached.).
          * \param csa     Pointer to the corresponding CSA. Not used in this class.
          * \par Time complexity
          *      Linear in the size of the suffix array.
          */
         _sa_order_sampling(const cache_config& cconfig, SDSL_UNUSED const t_csa* csa=nullptr)
         {
-            int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
-            size_type n = sa_buf.size();
-            this->width(bits::hi(n)+1);
-            this->resize((n+sample_dens-1)/sample_dens);
-
-            for (size_type i=0, cnt_mod=sample_dens, cnt_sum=0; i < n; ++i, ++cnt_mod) {
-                size_type sa = sa_buf[i];
-                if (sample_dens == cnt_mod) {
-                    cnt_mod = 0;
-                    base_type::operator[](cnt_sum++) = sa;
-                }
+            if (cache_file_exists(conf::KEY_SA, cconfig)) {
+                int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
+                init(sa_buf);
+            } else {
+                sa_samples_buffer sa_buf(cconfig);
+                init(sa_buf);
             }
         }
 
@@ -109,6 +105,23 @@ class _sa_order_sampling : public int_vector<t_width>
         {
             return base_type::operator[](i/sample_dens);
         }
+
+    private:
+        template<class t_sa_buf>
+        void init(t_sa_buf& sa_buf)
+        {
+            size_type n = sa_buf.size();
+            this->width(bits::hi(n)+1);
+            this->resize((n+sample_dens-1)/sample_dens);
+
+            for (size_type i=0, cnt_mod=sample_dens, cnt_sum=0; i < n; ++i, ++cnt_mod) {
+                size_type sa = sa_buf[i];
+                if (sample_dens == cnt_mod) {
+                    cnt_mod = 0;
+                    base_type::operator[](cnt_sum++) = sa;
+                }
+            }
+        }
 };
 
 template<uint8_t t_width=0>
@@ -146,28 +159,20 @@ class _text_order_sampling : public int_vector<t_width>
 
         //! Constructor
         /*
-         * \param cconfig Cache configuration (SA is expected to be cached.).
+         * \param cconfig Cache configuration (SA or SA samples are expected to be cached.).
          * \param csa    Pointer to the corresponding CSA. Not used in this class.
          * \par Time complexity
          *      Linear in the size of the suffix array.
          */
         _text_order_sampling(const cache_config& cconfig, SDSL_UNUSED const t_csa* csa=nullptr)
         {
-            int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
-            size_type n = sa_buf.size();
-            bit_vector marked(n, 0);                // temporary bitvector for the marked text positions
-            this->width(bits::hi(n/sample_dens)+1);
-            this->resize((n+sample_dens-1)/sample_dens);
-
-            for (size_type i=0, sa_cnt=0; i < n; ++i) {
-                size_type sa = sa_buf[i];
-                if (0 == (sa % sample_dens)) {
-                    marked[i] = 1;
-                    base_type::operator[](sa_cnt++) = sa / sample_dens;
-                }
+            if (cache_file_exists(conf::KEY_SA, cconfig)) {
+                int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
+                init(sa_buf);
+            } else {
+                sa_samples_buffer sa_buf(cconfig);
+                init(sa_buf);
             }
-            m_marked = std::move(t_bv(marked));
-            util::init_support(m_rank_marked, &m_marked);
         }
 
         //! Copy constructor
@@ -233,6 +238,26 @@ class _text_order_sampling : public int_vector<t_width>
             m_rank_marked.load(in);
             m_rank_marked.set_vector(&m_marked);
         }
+
+    private:
+        template<class t_sa_buf>
+        void init(t_sa_buf& sa_buf)
+        {
+            size_type n = sa_buf.size();
+            bit_vector marked(n, 0);                // temporary bitvector for the marked text positions
+            this->width(bits::hi(n/sample_dens)+1);
+            this->resize((n+sample_dens-1)/sample_dens);
+
+            for (size_type i=0, sa_cnt=0; i < n; ++i) {
+                size_type sa = sa_buf[i];
+                if (0 == (sa % sample_dens)) {
+                    marked[i] = 1;
+                    base_type::operator[](sa_cnt++) = sa / sample_dens;
+                }
+            }
+            m_marked = std::move(t_bv(marked));
+            util::init_support(m_rank_marked, &m_marked);
+        }
 };
 
 template<class t_bit_vec=sd_vector<>,
@@ -618,26 +643,19 @@ class _isa_sampling : public int_vector<t_width>
 
         //! Constructor
         /*
-         * \param cconfig   Cache configuration (SA is expected to be cached.).
+         * \param cconfig   Cache configuration (SA or SA samples are expected to be cached.).
          * \param sa_sample Pointer to the corresponding SA sampling. Not used in this class.
          * \par Time complexity
          *      Linear in the size of the suffix array.
          */
         _isa_sampling(const cache_config& cconfig, SDSL_UNUSED const sa_type* sa_sample=nullptr)
         {
-            int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
-            size_type n = sa_buf.size();
-            if (n >= 1) { // so n+t_csa::isa_sample_dens >= 2
-                this->width(bits::hi(n)+1);
-                this->resize((n-1)/sample_dens+1);
-            }
-            for (size_type i=0; i < this->size(); ++i) base_type::operator[](i) = 0;
-
-            for (size_type i=0; i < n; ++i) {
-                size_type sa = sa_buf[i];
-                if ((sa % sample_dens) == 0) {
-                    base_type::operator[](sa/sample_dens) = i;
-                }
+            if (cache_file_exists(conf::KEY_SA, cconfig)) {
+                int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
+                init(sa_buf);
+            } else {
+                sa_samples_buffer sa_buf(cconfig);
+                init(sa_buf);
             }
         }
 
@@ -670,6 +688,25 @@ class _isa_sampling : public int_vector<t_width>
         }
 
         void set_vector(SDSL_UNUSED const sa_type*) {}
+
+    private:
+        template<class t_sa_buf>
+        void init(t_sa_buf& sa_buf)
+        {
+            size_type n = sa_buf.size();
+            if (n >= 1) { // so n+t_csa::isa_sample_dens >= 2
+                this->width(bits::hi(n)+1);
+                this->resize((n-1)/sample_dens+1);
+            }
+            for (size_type i=0; i < this->size(); ++i) base_type::operator[](i) = 0;
+
+            for (size_type i=0; i < n; ++i) {
+                size_type sa = sa_buf[i];
+                if ((sa % sample_dens) == 0) {
+                    base_type::operator[](sa/sample_dens) = i;
+                }
+            }
+        }
 };
 
 template<uint8_t t_width=0>
@@ -947,6 +984,26 @@ struct fuzzy_isa_sampling_support {
     using sampling_category = isa_sampling_tag;
 };
 
+template<class t_csa, uint8_t t_width>
+struct sa_samples_trait<_sa_order_sampling<t_csa, t_width>> {
+    enum { value = true };
+};
+
+template<class t_csa, class t_bv, class t_rank, uint8_t t_width>
+struct sa_samples_trait<_text_order_sampling<t_csa, t_bv, t_rank, t_width>> {
+    enum { value = true };
+};
+
+template<class t_csa, uint8_t t_width>
+struct sa_samples_trait<_isa_sampling<t_csa, t_width>> {
+    enum { value = true };
+};
+
+template<class t_csa, class t_inv_perm, class t_sel>
+struct sa_samples_trait<_text_order_isa_sampling_support<t_csa, t_inv_perm, t_sel>> {
+    enum { value = true };
+};
+
 } // end namespace
 
 #endif
@@ -25,9 +25,11 @@
 #include "suffix_array_helper.hpp"
 #include "iterators.hpp"
 #include "util.hpp"
-#include "fast_cache.hpp"
 #include "csa_sampling_strategy.hpp"
 #include "csa_alphabet_strategy.hpp"
+#include "kmer_table.hpp"
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
 #include <iostream>
 #include <algorithm> // for std::swap
 #include <cassert>
@@ -53,6 +55,8 @@ class bwt_of_csa_wt;   // forward declaration of BWT-array class
   *  \tparam t_sa_sample_strat Policy of SA sampling. E.g. sample in SA-order or text-order.
   *  \tparam t_isa             Vector type for ISA sample values.
   *  \tparam t_alphabet_strat  Policy for alphabet representation.
+  *  \tparam t_kmer_table      Table of the SA intervals of short strings, which
+  *                            speeds up the first backward search steps.
   *
   *  \sa sdsl::csa_sada, sdsl::csa_bitcompressed
   * @ingroup csa
@@ -63,7 +67,8 @@ template<class t_wt              = wt_huff<>,              // Wavelet tree type
          class t_sa_sample_strat = sa_order_sa_sampling<>, // Policy class for the SA sampling.
          class t_isa_sample_strat= isa_sampling<>,         // Policy class for ISA sampling.
          class t_alphabet_strat  =                         // Policy class for the representation of the alphabet.
-         typename wt_alphabet_trait<t_wt>::type
+         typename wt_alphabet_trait<t_wt>::type,
+         class t_kmer_table      = kmer_table<>            // Table of SA intervals of all strings of length k.
          >
 class csa_wt
 {
@@ -106,6 +111,7 @@ class csa_wt
         typedef typename t_sa_sample_strat::template type<csa_wt>  sa_sample_type;
         typedef typename t_isa_sample_strat::template type<csa_wt> isa_sample_type;
         typedef t_alphabet_strat                                   alphabet_type;
+        typedef t_kmer_table                                       kmer_table_type;
         typedef typename alphabet_type::char_type                  char_type; // Note: This is the char type of the CSA not the WT!
         typedef typename alphabet_type::comp_char_type             comp_char_type;
         typedef typename alphabet_type::string_type                string_type;
@@ -121,10 +127,7 @@ class csa_wt
         sa_sample_type  m_sa_sample;    // suffix array samples
         isa_sample_type m_isa_sample;   // inverse suffix array samples
         alphabet_type   m_alphabet;
-//#define USE_CSA_CACHE
-#ifdef USE_CSA_CACHE
-        mutable fast_cache csa_cache;
-#endif
+        kmer_table_type m_kmers;        // SA intervals of short strings
 
         void copy(const csa_wt& csa)
         {
@@ -133,6 +136,7 @@ class csa_wt
             m_isa_sample   = csa.m_isa_sample;
             m_isa_sample.set_vector(&m_sa_sample);
             m_alphabet     = csa.m_alphabet;
+            m_kmers        = csa.m_kmers;
         }
 
     public:
@@ -150,6 +154,7 @@ class csa_wt
         const sa_sample_type&                         sa_sample    = m_sa_sample;
         const isa_sample_type&                        isa_sample   = m_isa_sample;
         const wavelet_tree_type&                      wavelet_tree = m_wavelet_tree;
+        const kmer_table_type&                        kmers        = m_kmers;
 
         //! Default constructor
         csa_wt() {}
@@ -274,6 +279,18 @@ class csa_wt
             return m_wavelet_tree.rank(i, c);
         }
 
+        // Calculates rank_bwt(i, c) and rank_bwt(j, c), fused if the wavelet tree supports it.
+        std::pair<size_type, size_type> rank_bwt_pair(size_type i, size_type j, const char_type c)const
+        {
+            return rank_pair(m_wavelet_tree, i, j, c);
+        }
+
+        // Prefetches the memory accessed by rank_bwt(i, c), if the wavelet tree supports it.
+        void prefetch_rank_bwt(size_type i)const
+        {
+            prefetch_rank(m_wavelet_tree, i);
+        }
+
         // Calculates the position of the i-th c in the BWT of the original text.
         /*
          *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -298,41 +315,75 @@ class csa_wt
 
 // == template functions ==
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::csa_wt(cache_config& config)
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::csa_wt(cache_config& config)
 {
     if (!cache_file_exists(key_trait<alphabet_type::int_width>::KEY_BWT, config)) {
         return;
     }
-    {
-        auto event = memory_monitor::event("construct csa-alpbabet");
-        int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
-        size_type n = bwt_buf.size();
-        alphabet_type tmp_alphabet(bwt_buf, n);
-        m_alphabet.swap(tmp_alphabet);
-    }
-    {
-        auto event = memory_monitor::event("construct wavelet tree");
-        int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
-        size_type n = bwt_buf.size();
-        wavelet_tree_type tmp_wt(bwt_buf, n);
-        m_wavelet_tree.swap(tmp_wt);
-    }
-    {
-        auto event = memory_monitor::event("sample SA");
-        sa_sample_type tmp_sa_sample(config);
-        m_sa_sample.swap(tmp_sa_sample);
+    // The wavelet tree depends only on the BWT and the samples only on the SA,
+    // so both can be built concurrently. The samples use a copy of config.
+    cache_config sample_config = config;
+    sample_config.stage_times.clear();
+    auto construct_wt = [&]() {
+        {
+            stage_timer timer(config.stage_times, "construct csa-alphabet");
+            int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
+            size_type n = bwt_buf.size();
+            alphabet_type tmp_alphabet(bwt_buf, n);
+            m_alphabet.swap(tmp_alphabet);
+        }
+        {
+            stage_timer timer(config.stage_times, "construct wavelet tree");
+            int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
+            size_type n = bwt_buf.size();
+            wavelet_tree_type tmp_wt(bwt_buf, n);
+            m_wavelet_tree.swap(tmp_wt);
+        }
+    };
+    auto construct_samples = [&]() {
+        {
+            stage_timer timer(sample_config.stage_times, "sample SA");
+            sa_sample_type tmp_sa_sample(sample_config);
+            m_sa_sample.swap(tmp_sa_sample);
+        }
+        {
+            stage_timer timer(sample_config.stage_times, "sample ISA");
+            isa_sample_type isa_s(sample_config, &m_sa_sample);
+            util::swap_support(m_isa_sample, isa_s, &m_sa_sample, &m_sa_sample);
+        }
+    };
+    if (construct_config::pipeline and construct_config::num_threads > 1) {
+        auto event = memory_monitor::event("construct wavelet tree and sample SA/ISA");
+        parallel::run(2, [&](uint64_t t) {
+            if (t == 0) {
+                construct_wt();
+            } else {
+                construct_samples();
+            }
+        });
+    } else {
+        {
+            auto event = memory_monitor::event("construct wavelet tree");
+            construct_wt();
+        }
+        {
+            auto event = memory_monitor::event("sample SA/ISA");
+            construct_samples();
+        }
     }
-    {
-        auto event = memory_monitor::event("sample ISA");
-        isa_sample_type isa_s(config, &m_sa_sample);
-        util::swap_support(m_isa_sample, isa_s, &m_sa_sample, &m_sa_sample);
+    config.stage_times.insert(config.stage_times.end(), sample_config.stage_times.begin(), sample_config.stage_times.end());
+    config.file_map.insert(sample_config.file_map.begin(), sample_config.file_map.end());
+    if (kmer_table_type::max_k > 0) {
+        stage_timer timer(config.stage_times, "construct k-mer table");
+        kmer_table_type tmp_kmers(*this, config.kmer_table_budget);
+        m_kmers.swap(tmp_kmers);
     }
 }
 
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-inline auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::operator[](size_type i)const -> value_type
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+inline auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::operator[](size_type i)const -> value_type
 {
     size_type off = 0;
     while (!m_sa_sample.is_sampled(i)) {
@@ -348,8 +399,8 @@ inline auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabe
 }
 
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::operator=(const csa_wt<t_wt,t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa) -> csa_wt& {
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::operator=(const csa_wt<t_wt,t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa) -> csa_wt& {
     if (this != &csa)
     {
         copy(csa);
@@ -357,21 +408,22 @@ auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     return *this;
 }
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::operator=(csa_wt<t_wt,t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>&& csa) -> csa_wt& {
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::operator=(csa_wt<t_wt,t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>&& csa) -> csa_wt& {
     if (this != &csa)
     {
         m_wavelet_tree = std::move(csa.m_wavelet_tree);
         m_sa_sample    = std::move(csa.m_sa_sample);
         m_isa_sample   = std::move(csa.m_isa_sample);
         m_alphabet     = std::move(csa.m_alphabet);
+        m_kmers        = std::move(csa.m_kmers);
     }
     return *this;
 }
 
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const -> size_type
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const -> size_type
 {
     structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
     size_type written_bytes = 0;
@@ -379,27 +431,30 @@ auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     written_bytes += m_sa_sample.serialize(out, child, "sa_samples");
     written_bytes += m_isa_sample.serialize(out, child, "isa_samples");
     written_bytes += m_alphabet.serialize(out, child, "alphabet");
+    written_bytes += m_kmers.serialize(out, child, "kmers");
     structure_tree::add_size(child, written_bytes);
     return written_bytes;
 }
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::load(std::istream& in)
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::load(std::istream& in)
 {
     m_wavelet_tree.load(in);
     m_sa_sample.load(in);
     m_isa_sample.load(in, &m_sa_sample);
     m_alphabet.load(in);
+    m_kmers.load(in);
 }
 
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
-void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::swap(csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa)
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
+void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::swap(csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa)
 {
     if (this != &csa) {
         m_wavelet_tree.swap(csa.m_wavelet_tree);
         m_sa_sample.swap(csa.m_sa_sample);
         util::swap_support(m_isa_sample, csa.m_isa_sample, &m_sa_sample, &(csa.m_sa_sample));
         m_alphabet.swap(csa.m_alphabet);
+        m_kmers.swap(csa.m_kmers);
     }
 }
 
@@ -26,7 +26,7 @@
  *     - replace std::vectors by int_vectors
  *     - add support for rank0
  *     - added naive implementation of method get_int
- *     - TODO: added a naive implementation of select
+ *     - added select support with sampled superblocks
 */
 #ifndef INCLUDED_SDSL_HYB_VECTOR
 #define INCLUDED_SDSL_HYB_VECTOR
@@ -781,6 +781,28 @@ class rank_support_hyb
             return rank(i);
         }
 
+        //! Prefetches the hyperblock and superblock headers which are accessed by rank(i).
+        void prefetch(size_type i) const
+        {
+            size_type block_id = (i > 0 ? i - 1 : 0) / bit_vector_type::k_block_size;
+            size_type sblock_id = block_id / k_sblock_rate;
+            size_type hblock_id = block_id / bit_vector_type::k_hblock_rate;
+            __builtin_prefetch(m_v->m_hblock_header.data() + 2 * hblock_id);
+            __builtin_prefetch(((const uint8_t*)(m_v->m_sblock_header.data())) + (sblock_id * bit_vector_type::k_sblock_header_size));
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out) const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_hyb::rank(i); });
+        }
+
         //! Return the size of the original vector
         const size_type size() const
         {
@@ -824,31 +846,175 @@ class rank_support_hyb
 /*!
  * \tparam t_b            The bit pattern of size one. (so `0` or `1`)
  * \tparam k_sblock_rate  Superblock rate (number of blocks inside superblock)
- * TODO: implement select queries, currently this is dummy class.
+ *
+ * The superblock of every sample_rate-th occurrence is sampled. A query
+ * searches the superblock between two samples by the ranks stored in the
+ * superblock headers, skips the preceding blocks of the superblock by
+ * their popcounts and decodes the found block.
  */
 template<uint8_t t_b, uint32_t k_sblock_rate>
 class select_support_hyb
 {
+        static_assert(t_b == 1 or t_b == 0 , "select_support_hyb only supports bitpatterns 0 or 1.");
     public:
         typedef hyb_vector<k_sblock_rate> bit_vector_type;
         typedef typename bit_vector_type::size_type size_type;
         enum { bit_pat = t_b };
         enum { bit_pat_len = (uint8_t)1 };
+        enum { sample_rate = 4096 };
     private:
         const bit_vector_type* m_v;
+        int_vector<> m_samples;  // Superblock of the (k*sample_rate+1)-th occurrence, followed by the last superblock
+
+        //! Header of superblock s.
+        const uint32_t* sblock_header(size_type s) const
+        {
+            return (const uint32_t*)(((const uint8_t*)m_v->m_sblock_header.data()) + s * bit_vector_type::k_sblock_header_size);
+        }
+
+        //! Number of occurrences before superblock s.
+        size_type args_before(size_type s) const
+        {
+            size_type hblock_id = (s * k_sblock_rate) / bit_vector_type::k_hblock_rate;
+            size_type ones = m_v->m_hblock_header[2 * hblock_id + 1] + sblock_header(s)[1];
+            return t_b ? ones : s * bit_vector_type::k_sblock_size - ones;
+        }
+
+        //! Position of the j-th occurrence inside a block.
+        /*! \param trunk_p Encoding of the block in the trunk.
+         *  \param header  16-bit header of the block.
+         *  \param j       Rank of the occurrence; in [1..number of occurrences in the block].
+         */
+        static uint32_t select_in_block(const uint8_t* trunk_p, uint16_t header, uint32_t j)
+        {
+            const uint32_t block_size = bit_vector_type::k_block_size;
+            uint32_t encoding_size = (header >> 10);
+            uint32_t ones = (header & 0x1ff);
+            uint32_t zeros = block_size - ones;
+            uint32_t special_bit = ((header & 0x200) >> 9);
+
+            // Number of runs <= 2; the first run consists of special bits.
+            if (!encoding_size) {
+                uint32_t first_run_length = special_bit ? ones : zeros;
+                return (special_bit == t_b) ? j - 1 : first_run_length + j - 1;
+            }
+
+            // Number of runs > 2.
+            if (encoding_size < bit_vector_type::k_block_bytes) {
+                if (std::min(ones, zeros) == encoding_size) {
+                    // Minority encoding: sorted positions of the special bits.
+                    if (special_bit == t_b)
+                        return trunk_p[j - 1];
+                    uint32_t pos = j - 1;
+                    for (uint32_t k = 0; k < encoding_size and trunk_p[k] <= pos; ++k)
+                        ++pos;
+                    return pos;
+                }
+
+                // Runs encoding: ends of all but the last two runs, the first
+                // run consists of special bits.
+                int32_t last = -1;
+                uint32_t counted = 0;
+                for (uint32_t k = 0; k < encoding_size; ++k) {
+                    uint32_t len = trunk_p[k] - last;
+                    if ((special_bit ^ (k & 1)) == t_b) {
+                        if (j <= len)
+                            return last + j;
+                        j -= len;
+                        counted += len;
+                    }
+                    last = trunk_p[k];
+                }
+                if ((special_bit ^ (encoding_size & 1)) == t_b)
+                    return last + j;
+                // The last run ends at the end of the block and holds the remaining occurrences.
+                uint32_t args = t_b ? ones : zeros;
+                return block_size - (args - counted) + j - 1;
+            }
+
+            // Plain encoding.
+            const uint64_t* trunk_p64 = (const uint64_t*)trunk_p;
+            uint32_t res = 0;
+            uint64_t w = t_b ? *trunk_p64 : ~*trunk_p64;
+            uint32_t args = bits::cnt(w);
+            while (args < j) {
+                j -= args;
+                ++trunk_p64;
+                w = t_b ? *trunk_p64 : ~*trunk_p64;
+                args = bits::cnt(w);
+                res += 64;
+            }
+            return res + bits::sel(w, j);
+        }
 
     public:
         //! Standard constructor
         explicit select_support_hyb(const bit_vector_type* v = nullptr)
         {
             set_vector(v);
+            if (v == nullptr or v->size() == 0)
+                return;
+            size_type sblocks = v->m_sblock_header.size() / bit_vector_type::k_sblock_header_size;
+            size_type ones = rank_support_hyb<1, k_sblock_rate>(v).rank(v->size());
+            size_type total = t_b ? ones : v->size() - ones;
+            size_type sample_cnt = (total + sample_rate - 1) / sample_rate;
+            m_samples = int_vector<>(sample_cnt + 1, 0, bits::hi(sblocks) + 1);
+            size_type k = 0, next = 1;
+            for (size_type s = 0; s + 1 < sblocks and k < sample_cnt; ++s) {
+                size_type end = args_before(s + 1);
+                while (k < sample_cnt and next <= end) {
+                    m_samples[k++] = s;
+                    next += sample_rate;
+                }
+            }
+            while (k < sample_cnt) {  // occurrences in the last superblock
+                m_samples[k++] = sblocks - 1;
+            }
+            m_samples[sample_cnt] = sblocks - 1;
         }
 
-        //! Answers select queries
-        size_type select(size_type) const
+        //! Returns the position of the i-th occurrence in the bit vector.
+        /*! \pre i in [1..rank(size())]
+         */
+        size_type select(size_type i) const
         {
-            fprintf(stderr, "\nhyb_vector: select queries are not currently supported\n");
-            std::exit(EXIT_FAILURE);
+            assert(m_v != nullptr);
+            assert(i > 0);
+            size_type k = (i - 1) / sample_rate;
+            size_type lb = m_samples[k], rb = m_samples[k + 1];
+            // find the last superblock s in [lb..rb] with args_before(s) < i
+            while (lb < rb) {
+                size_type mid = lb + (rb - lb + 1) / 2;
+                if (args_before(mid) < i) {
+                    lb = mid;
+                } else {
+                    rb = mid - 1;
+                }
+            }
+            i -= args_before(lb);
+            const uint32_t* header_ptr32 = sblock_header(lb);
+            size_type block_id = lb * k_sblock_rate;
+
+            // Uniform superblock optimization.
+            if ((*header_ptr32) & 0x80000000)
+                return block_id * bit_vector_type::k_block_size + i - 1;
+
+            // Skip the preceding blocks of the superblock.
+            size_type hblock_id = block_id / bit_vector_type::k_hblock_rate;
+            size_type trunk_ptr = m_v->m_hblock_header[2 * hblock_id] + ((*header_ptr32) & 0x3fffffff);
+            const uint16_t* header_ptr16 = (const uint16_t*)(header_ptr32 + 2);
+            while (true) {
+                uint32_t ones = ((*header_ptr16) & 0x1ff);
+                uint32_t args = t_b ? ones : bit_vector_type::k_block_size - ones;
+                if (args >= i)
+                    break;
+                i -= args;
+                trunk_ptr += ((*header_ptr16) >> 10);
+                ++header_ptr16;
+                ++block_id;
+            }
+            const uint8_t* trunk_p = ((const uint8_t*)m_v->m_trunk.data()) + trunk_ptr;
+            return block_id * bit_vector_type::k_block_size + select_in_block(trunk_p, *header_ptr16, i);
         }
 
         //! Shorthand for select(i)
@@ -857,6 +1023,24 @@ class select_support_hyb
             return select(i);
         }
 
+        //! Prefetches the samples which are accessed by select(i).
+        void prefetch(size_type i) const
+        {
+            util::prefetch(m_samples, (i - 1) / sample_rate);
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out) const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_support_hyb::select(i); });
+        }
+
         //! Return the size of the original vector
         const size_type size() const
         {
@@ -870,29 +1054,35 @@ class select_support_hyb
         }
 
         //! Assignment operator
-        select_support_hyb& operator=(const select_support_hyb& rs)
+        select_support_hyb& operator=(const select_support_hyb& ss)
         {
-            if (this != &rs) {
-                set_vector(rs.m_v);
+            if (this != &ss) {
+                m_samples = ss.m_samples;
+                set_vector(ss.m_v);
             }
             return *this;
         }
 
         //! Swap method
-        void swap(select_support_hyb&) {}
+        void swap(select_support_hyb& ss)
+        {
+            m_samples.swap(ss.m_samples);
+        }
 
         //! Load the data structure from a stream and set the supported vector
-        void load(std::istream&, const bit_vector_type* v = nullptr)
+        void load(std::istream& in, const bit_vector_type* v = nullptr)
         {
+            m_samples.load(in);
             set_vector(v);
         }
 
         //! Serializes the data structure into a stream
-        size_type serialize(std::ostream&, structure_tree_node* v = nullptr, std::string name = "") const
+        size_type serialize(std::ostream& out, structure_tree_node* v = nullptr, std::string name = "") const
         {
             structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
-            structure_tree::add_size(child, 0);
-            return 0;
+            size_type written_bytes = m_samples.serialize(out, child, "samples");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
         }
 };
 
@@ -287,6 +287,7 @@ class int_vector
         size_type      m_size;  //!< Number of bits needed to store int_vector.
         uint64_t*      m_data;  //!< Pointer to the memory for the bits.
         int_width_type m_width; //!< Width of the integers.
+        bool           m_mapped = false; //!< True if m_data points into a mapped file.
 
     public:
 
@@ -400,6 +401,21 @@ class int_vector
         */
         void set_int(size_type idx, value_type x, const uint8_t len=64);
 
+        //! Copies the elements [begin..end-1] to out[0..end-begin-1].
+        /*! Faster than element-wise access for long ranges, see bits::read_ints.
+            \param begin Index of the first element.
+            \param end   Index after the last element; end <= size().
+            \param out   Pointer to an array of at least end-begin integers.
+            \sa set_range
+        */
+        void get_range(size_type begin, size_type end, uint64_t* out) const;
+
+        //! Sets the elements [begin..end-1] to in[0..end-begin-1].
+        /*! Each value is truncated to width() bits.
+            \sa get_range
+        */
+        void set_range(size_type begin, size_type end, const uint64_t* in);
+
         //! Returns the width of the integers which are accessed via the [] operator.
         /*! \returns The width of the integers which are accessed via the [] operator.
             \sa width
@@ -1132,10 +1148,11 @@ inline int_vector<t_width>::int_vector(size_type size, value_type default_value,
 
 template<uint8_t t_width>
 inline int_vector<t_width>::int_vector(int_vector&& v) :
-    m_size(v.m_size), m_data(v.m_data), m_width(v.m_width)
+    m_size(v.m_size), m_data(v.m_data), m_width(v.m_width), m_mapped(v.m_mapped)
 {
     v.m_data = nullptr; // ownership of v.m_data now transfered
     v.m_size = 0;
+    v.m_mapped = false;
 }
 
 template<uint8_t t_width>
@@ -1193,6 +1210,7 @@ void int_vector<t_width>::swap(int_vector& v)
         v.m_size = size;
         v.m_data = data;
         v.width(int_width);
+        std::swap(m_mapped, v.m_mapped);
     }
 }
 
@@ -1230,6 +1248,28 @@ inline void int_vector<t_width>::set_int(size_type idx, value_type x, const uint
     bits::write_int(m_data+(idx>>6), x, idx&0x3F, len);
 }
 
+template<uint8_t t_width>
+void int_vector<t_width>::get_range(size_type begin, size_type end, uint64_t* out)const
+{
+#ifdef SDSL_DEBUG
+    if (begin > end or end > size()) {
+        throw std::out_of_range("OUT_OF_RANGE_ERROR: int_vector::get_range(size_type, size_type, uint64_t*); end > size()!");
+    }
+#endif
+    bits::read_ints(m_data, begin*m_width, m_width, end-begin, out);
+}
+
+template<uint8_t t_width>
+void int_vector<t_width>::set_range(size_type begin, size_type end, const uint64_t* in)
+{
+#ifdef SDSL_DEBUG
+    if (begin > end or end > size()) {
+        throw std::out_of_range("OUT_OF_RANGE_ERROR: int_vector::set_range(size_type, size_type, const uint64_t*); end > size()!");
+    }
+#endif
+    bits::write_ints(m_data, begin*m_width, m_width, end-begin, in);
+}
+
 template<uint8_t t_width>
 inline auto int_vector<t_width>::operator[](const size_type& idx) -> reference {
     assert(idx < this->size());
@@ -1412,11 +1452,17 @@ typename int_vector<t_width>::size_type int_vector<t_width>::serialize(std::ostr
 {
     structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
     size_type written_bytes = 0;
+    bool aligned = aligned_format::writing(out);
+    uint64_t offset = aligned ? (uint64_t)out.tellp() : 0;
     if (t_width > 0 and write_fixed_as_variable) {
         written_bytes += int_vector<0>::write_header(m_size, t_width, out);
     } else {
         written_bytes += int_vector<t_width>::write_header(m_size, m_width, out);
     }
+    if (aligned) {
+        written_bytes += aligned_format::pad(out);
+        aligned_format::record(child, offset, out.tellp(), m_size, m_width);
+    }
     written_bytes += write_data(out);
     structure_tree::add_size(child, written_bytes);
     return written_bytes;
@@ -1427,7 +1473,10 @@ void int_vector<t_width>::load(std::istream& in)
 {
     size_type size;
     int_vector<t_width>::read_header(size, m_width, in);
-
+    aligned_format::skip(in);
+    if (memory_manager::map_payload(*this, size, in)) {
+        return;
+    }
     bit_resize(size);
     uint64_t* p = m_data;
     size_type idx = 0;
@@ -306,6 +306,46 @@ class int_vector_buffer
             write(m_size, value);
         }
 
+        //! Reads the elements [begin..end-1] into out[0..end-begin-1].
+        /*! Decodes the blocks with int_vector::get_range instead of element by element.
+         *  \pre end <= size()
+         */
+        void get_range(uint64_t begin, uint64_t end, uint64_t* out) {
+            assert(is_open());
+            assert(end <= m_size);
+            while (begin < end) {
+                if (begin < m_begin or m_begin+m_buffersize <= begin) {
+                    write_block();
+                    read_block(begin);
+                }
+                uint64_t e = std::min(end, m_begin+m_buffersize);
+                m_buffer.get_range(begin-m_begin, e-m_begin, out);
+                out += e-begin;
+                begin = e;
+            }
+        }
+
+        //! Writes in[0..end-begin-1] to the elements [begin..end-1].
+        /*! The int_vector_buffer grows if end > size().
+         */
+        void set_range(uint64_t begin, uint64_t end, const uint64_t* in) {
+            assert(is_open());
+            while (begin < end) {
+                if (begin < m_begin or m_begin+m_buffersize <= begin) {
+                    write_block();
+                    read_block(begin);
+                }
+                uint64_t e = std::min(end, m_begin+m_buffersize);
+                m_buffer.set_range(begin-m_begin, e-m_begin, in);
+                m_need_to_write = true;
+                if (m_size < e) {
+                    m_size = e;
+                }
+                in += e-begin;
+                begin = e;
+            }
+        }
+
         //! Close the int_vector_buffer.
         /*! It is not possible to read from / write into the int_vector_buffer after calling this method
          *  \param remove_file If true, the underlying file will be removed on closing.
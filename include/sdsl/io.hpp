@@ -24,7 +24,9 @@
 #include "util.hpp"
 #include "sdsl_concepts.hpp"
 #include "structure_tree.hpp"
+#include "memory_management.hpp"
 #include <algorithm>
+#include <set>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -107,6 +109,129 @@ void read_member(T& t, std::istream& in)
 template<>
 void read_member<std::string>(std::string& t, std::istream& in);
 
+//! Serialization format which aligns int_vector payloads to 64-byte boundaries.
+/*! Files written by store_to_file_aligned start with a header of
+ *  header_size bytes (magic, version, offset and length of the table of
+ *  contents), followed by the serialized object. Each int_vector header
+ *  inside the object is followed by zero bytes up to the next multiple of
+ *  `alignment`, so payloads can be used in place with aligned or SIMD loads.
+ *  The table of contents at the end of the file lists path, type, offset,
+ *  size and width of every int_vector, which allows to load components lazily.
+ *  load_from_file detects the format by its magic number.
+ */
+class aligned_format
+{
+    public:
+        static constexpr uint64_t magic       = 0x34362d6c7364738aULL; // "\x8asdsl-64"
+        static constexpr uint64_t version     = 1;
+        static constexpr uint64_t alignment   = 64;
+        static constexpr uint64_t header_size = 64;
+
+        struct toc_entry {
+            std::string path;    // names of the members from the root, separated by '/'
+            std::string type;    // class name of the int_vector
+            uint64_t    offset;  // file offset of the int_vector header
+            uint64_t    payload; // file offset of the aligned payload
+            uint64_t    size;    // size in bits
+            uint8_t     width;
+        };
+    private:
+        struct context {
+            const std::ostream*    out = nullptr;
+            const std::istream*    in  = nullptr;
+            std::vector<toc_entry> toc;
+            std::set<std::string>  paths; // paths in toc
+        };
+        static context& the_context() {
+            static thread_local context c;
+            return c;
+        }
+    public:
+        //! Writes the file header.
+        static void write_header(std::ostream& out, uint64_t toc_offset, uint64_t toc_entries);
+        //! Reads the file header at the current position; returns false if `in` is not in aligned format.
+        static bool read_header(std::istream& in, uint64_t& toc_offset, uint64_t& toc_entries);
+        static void write_toc(const std::vector<toc_entry>& toc, std::ostream& out);
+        //! Reads the table of contents of `file`.
+        /*! Returns false if `file` is not in aligned format or lists a path twice.
+         */
+        static bool read_toc(const std::string& file, std::vector<toc_entry>& toc);
+
+        //! Checks if `out` is written in aligned format.
+        static bool writing(const std::ostream& out) {
+            return the_context().out == &out;
+        }
+        //! Writes zero bytes up to the next aligned position if `out` is written in aligned format.
+        static uint64_t pad(std::ostream& out) {
+            static const char zeros[alignment] = {};
+            if (!writing(out)) {
+                return 0;
+            }
+            uint64_t padding = (alignment - (uint64_t)out.tellp() % alignment) % alignment;
+            out.write(zeros, padding);
+            return padding;
+        }
+        //! Skips the padding written by pad if `in` is read in aligned format.
+        static void skip(std::istream& in) {
+            if (the_context().in != &in) {
+                return;
+            }
+            uint64_t padding = (alignment - (uint64_t)in.tellg() % alignment) % alignment;
+            in.seekg(padding, std::ios_base::cur);
+        }
+        //! Adds the int_vector of node v to the table of contents.
+        /*! Members without a path or with a path which is already listed get
+         *  "#" and the index of the entry appended, e.g. "#3" or "wavelet_tree/bv#7",
+         *  so every path is unique.
+         */
+        static void record(const structure_tree_node* v, uint64_t offset, uint64_t payload,
+                           uint64_t size, uint8_t width);
+
+        //! Serialize to `out` in aligned format during the lifetime of the object.
+        class write_scope
+        {
+            public:
+                write_scope(const std::ostream& out) {
+                    the_context().out = &out;
+                    the_context().toc.clear();
+                    the_context().paths.clear();
+                }
+                ~write_scope() {
+                    the_context().out = nullptr;
+                }
+                const std::vector<toc_entry>& toc() const {
+                    return the_context().toc;
+                }
+        };
+
+        //! Read file stream `in` in aligned format during the lifetime of the object, if its header says so.
+        /*! Leaves `in` after the file header in aligned format and at the
+         *  beginning of the file otherwise.
+         */
+        class read_scope
+        {
+            private:
+                bool m_aligned = false;
+            public:
+                read_scope(std::istream& in) {
+                    uint64_t toc_offset, toc_entries;
+                    m_aligned = read_header(in, toc_offset, toc_entries);
+                    if (m_aligned) {
+                        the_context().in = &in;
+                    } else {
+                        in.clear();
+                        in.seekg(0);
+                    }
+                }
+                ~read_scope() {
+                    if (m_aligned) {
+                        the_context().in = nullptr;
+                    }
+                }
+                bool aligned() const { return m_aligned; }
+        };
+};
+
 
 
 
@@ -171,6 +296,16 @@ void load(std::vector<X>& x, std::istream& in)
 template<class T>
 bool load_from_file(T& v, const std::string& file);
 
+//! Load sdsl-object v from a file, letting its int_vectors view a read-only mapping of the file.
+/*! The mapping is shared with the page cache and released when the last
+ *  int_vector pointing into it is destroyed. Payloads which do not start at
+ *  a multiple of 8 bytes, which is common in the default format, are read
+ *  to the heap; in files written by store_to_file_aligned all are mapped.
+ *  \sa memory_manager::use_mmap_load
+ */
+template<class T>
+bool load_from_file_mapped(T& v, const std::string& file);
+
 //! Load an int_vector from a plain array of `num_bytes`-byte integers with X in \{0, 1,2,4,8\} from disk.
 // TODO: Remove ENDIAN dependency.
 template<class t_int_vec>
@@ -254,6 +389,20 @@ bool load_vector_from_file(t_int_vec& v, const std::string& file, uint8_t num_by
 template<class T>
 bool store_to_file(const T& v, const std::string& file);
 
+//! Store a data structure to a file in aligned format.
+/*! Files in the RAM file system are stored in the default format.
+ *  \sa aligned_format
+ */
+template<class T>
+bool store_to_file_aligned(const T& v, const std::string& file);
+
+//! Load the int_vector stored under `path` from a file in aligned format.
+/*! The path is listed in the table of contents, see aligned_format::read_toc.
+ *  The payload is mapped if memory_manager::use_mmap_load is active.
+ */
+template<class t_int_vec>
+bool load_member_from_file(t_int_vec& v, const std::string& file, const std::string& path);
+
 //! Specialization of store_to_file for a char array
 bool store_to_file(const char* v, const std::string& file);
 
@@ -645,10 +794,21 @@ void add_hash(const T& t, std::ostream& out)
     write_member(hash_value, out);
 }
 
+//! Returns the path a store function writes `file` to.
+/*! Truncating a file which is mapped by load_from_file_mapped would
+ *  invalidate the int_vectors which view it. In this case the data is
+ *  written to a temporary file, which replaces `file` in finish_store.
+ */
+std::string store_path(const std::string& file);
+
+//! Moves the temporary file returned by store_path(file) to `file`.
+bool finish_store(const std::string& path, const std::string& file);
+
 template<class T>
 bool store_to_file(const T& t, const std::string& file)
 {
-    osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+    std::string path = store_path(file);
+    osfstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
     if (!out) {
         if (util::verbose) {
             std::cerr<<"ERROR: store_to_file not successful for: `"<<file<<"`"<<std::endl;
@@ -657,6 +817,9 @@ bool store_to_file(const T& t, const std::string& file)
     }
     serialize(t,out);
     out.close();
+    if (!finish_store(path, file)) {
+        return false;
+    }
     if (util::verbose) {
         std::cerr<<"INFO: store_to_file: `"<<file<<"`"<<std::endl;
     }
@@ -679,12 +842,49 @@ bool store_to_checked_file(const T& t, const std::string& file)
     return store_to_file(t, file);
 }
 
+template<class T>
+bool store_to_file_aligned(const T& t, const std::string& file)
+{
+    if (is_ram_file(file)) {
+        return store_to_file(t, file);
+    }
+    std::string path = store_path(file);
+    osfstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
+    if (!out) {
+        if (util::verbose) {
+            std::cerr<<"ERROR: store_to_file_aligned not successful for: `"<<file<<"`"<<std::endl;
+        }
+        return false;
+    }
+    aligned_format::write_header(out, 0, 0);
+    std::vector<aligned_format::toc_entry> toc;
+    {
+        structure_tree_node root("", util::class_name(t));
+        aligned_format::write_scope scope(out);
+        serialize(t, out, &root, "");
+        toc = scope.toc();
+    }
+    uint64_t toc_offset = out.tellp();
+    aligned_format::write_toc(toc, out);
+    out.seekp(0);
+    aligned_format::write_header(out, toc_offset, toc.size());
+    out.close();
+    if (!finish_store(path, file)) {
+        return false;
+    }
+    if (util::verbose) {
+        std::cerr<<"INFO: store_to_file_aligned: `"<<file<<"`"<<std::endl;
+    }
+    return true;
+}
+
 bool store_to_file(const char* v, const std::string& file);
 
 template<uint8_t t_width>
 bool store_to_file(const int_vector<t_width>& v, const std::string& file, bool write_fixed_as_variable)
 {
-    osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+    std::string path = store_path(file);
+    osfstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
     if (!out) {
         std::cerr<<"ERROR: util::store_to_file:: Could not open file `"<<file<<"`"<<std::endl;
         return false;
@@ -695,7 +895,7 @@ bool store_to_file(const int_vector<t_width>& v, const std::string& file, bool w
     }
     v.serialize(out, nullptr, "", write_fixed_as_variable);
     out.close();
-    return true;
+    return finish_store(path, file);
 }
 
 template<uint8_t t_width>
@@ -719,6 +919,9 @@ bool store_to_checked_file(const int_vector<t_width>& v, const std::string& file
 template<class T>
 bool load_from_file(T& v, const std::string& file)
 {
+    if (memory_manager::mmap_load_enabled() and !is_ram_file(file)) {
+        return load_from_file_mapped(v, file);
+    }
     isfstream in(file, std::ios::binary | std::ios::in);
     if (!in) {
         if (util::verbose) {
@@ -726,7 +929,10 @@ bool load_from_file(T& v, const std::string& file)
         }
         return false;
     }
-    load(v, in);
+    {
+        aligned_format::read_scope scope(in);
+        load(v, in);
+    }
     in.close();
     if (util::verbose) {
         std::cerr << "Load file `" << file << "`" << std::endl;
@@ -734,6 +940,84 @@ bool load_from_file(T& v, const std::string& file)
     return true;
 }
 
+template<class T>
+bool load_from_file_mapped(T& v, const std::string& file)
+{
+    if (is_ram_file(file)) {  // nothing to map
+        return load_from_file(v, file);
+    }
+    auto& registry = mmap_registry::the_registry();
+    size_t file_size = 0;
+    uint8_t* base = registry.map(file, file_size);
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (base == nullptr or !in) {
+        if (base != nullptr) {
+            registry.release(base);
+        }
+        if (util::verbose) {
+            std::cerr << "Could not map file `" << file << "`" << std::endl;
+        }
+        return false;
+    }
+    memory_manager::begin_mapped_load(in, base, file_size);
+    try {
+        aligned_format::read_scope scope(in);
+        load(v, in);
+    } catch (...) {
+        memory_manager::end_mapped_load();
+        registry.release(base);
+        throw;
+    }
+    memory_manager::end_mapped_load();
+    in.close();
+    // the int_vectors of v hold their own references to the mapping
+    registry.release(base);
+    if (util::verbose) {
+        std::cerr << "Map file `" << file << "`" << std::endl;
+    }
+    return true;
+}
+
+template<class t_int_vec>
+bool load_member_from_file(t_int_vec& v, const std::string& file, const std::string& path)
+{
+    std::vector<aligned_format::toc_entry> toc;
+    if (!aligned_format::read_toc(file, toc)) {
+        return false;
+    }
+    auto entry = std::find_if(toc.begin(), toc.end(),
+    [&path](const aligned_format::toc_entry& e) { return e.path == path; });
+    if (entry == toc.end()) {
+        return false;
+    }
+    auto& registry = mmap_registry::the_registry();
+    size_t file_size = 0;
+    uint8_t* base = nullptr;
+    if (memory_manager::mmap_load_enabled()) {
+        base = registry.map(file, file_size);
+    }
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (base != nullptr) {
+        memory_manager::begin_mapped_load(in, base, file_size);
+    }
+    try {
+        aligned_format::read_scope scope(in);
+        in.seekg(entry->offset);
+        v.load(in);
+    } catch (...) {
+        if (base != nullptr) {
+            memory_manager::end_mapped_load();
+            registry.release(base);
+        }
+        throw;
+    }
+    if (base != nullptr) {
+        memory_manager::end_mapped_load();
+        registry.release(base);
+    }
+    return true;
+}
+
 template<class T>
 bool load_from_checked_file(T& v, const std::string& file)
 {
@@ -0,0 +1,197 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file kmer_table.hpp
+   \brief kmer_table.hpp contains the sdsl::kmer_table class, which stores
+          the SA intervals of all strings of a fixed length k.
+   \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_KMER_TABLE
+#define INCLUDED_SDSL_KMER_TABLE
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "io.hpp"
+#include <vector>
+
+namespace sdsl
+{
+
+//! A table which maps each string of length k to its SA interval.
+/*!
+ *  The strings are formed over the symbols of the CSA except the
+ *  sentinel. String \f$x_0\ldots x_{k-1}\f$ is stored at index
+ *  \f$\sum_{i} (c_i-1)\sigma'^{k-1-i}\f$, where \f$c_i\f$ is the compact
+ *  symbol of \f$x_i\f$ and \f$\sigma'=\sigma-1\f$. Each entry holds the left
+ *  border and the exclusive right border of the interval, so backward
+ *  search can replace its first k steps by one lookup.
+ *
+ *  \tparam t_k Maximal length of the tabulated strings. t_k=0 disables the
+ *              table; it then occupies no space in the serialized CSA.
+ *
+ *  The table length k is the largest value \f$\leq t_k\f$ for which the
+ *  table has at most n entries and fits into the memory budget passed to
+ *  the constructor.
+ *
+ *  \sa sdsl::csa_wt, sdsl::csa_sada, sdsl::csa_bitcompressed
+ */
+template<uint8_t t_k=0>
+class kmer_table
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+        enum { max_k = t_k };
+
+    private:
+        uint8_t     m_k     = 0; // length of the tabulated strings, 0 if there is no table
+        uint64_t    m_sigma = 0; // number of symbols without the sentinel
+        int_vector<> m_bounds;   // m_bounds[2x] and m_bounds[2x+1] are the borders of string x
+
+    public:
+        kmer_table() = default;
+        kmer_table(const kmer_table&) = default;
+        kmer_table(kmer_table&&) = default;
+        kmer_table& operator=(const kmer_table&) = default;
+        kmer_table& operator=(kmer_table&&) = default;
+
+        //! Constructor
+        /*! \param csa       The CSA for which the intervals are computed.
+         *  \param max_bytes Memory budget for the table in bytes; 0 means no budget.
+         *  \par Time complexity
+         *       \f$ \Order{\sigma \cdot t \cdot t_{rank\_bwt}} \f$, where t is
+         *       the number of distinct substrings of length at most k.
+         */
+        template<class t_csa>
+        kmer_table(const t_csa& csa, uint64_t max_bytes=0)
+        {
+            size_type n = csa.size();
+            if (t_k == 0 or csa.sigma < 2) {
+                return;
+            }
+            uint64_t sigma = csa.sigma-1;
+            uint8_t width = bits::hi(n)+1;
+            uint64_t entries = 1;
+            uint8_t k = 0;
+            while (k < t_k and entries*sigma <= n and
+                   (max_bytes == 0 or (2*entries*sigma*width+7)/8 <= max_bytes)) {
+                entries *= sigma;
+                ++k;
+            }
+            if (k == 0) {
+                return;
+            }
+            m_k = k;
+            m_sigma = sigma;
+            m_bounds = int_vector<>(2*entries, 0, width);
+            // pow[d] is the weight of the symbol at distance d from the end of a string
+            std::vector<uint64_t> pow(k, 1);
+            for (uint8_t d=1; d < k; ++d) {
+                pow[d] = pow[d-1]*sigma;
+            }
+            // depth first traversal of the strings by backward search,
+            // which only descends into non-empty intervals
+            struct frame {
+                uint8_t  d;     // length of the matched suffix
+                uint64_t x;     // index contribution of the matched suffix
+                size_type l, r; // interval [l..r-1]
+            };
+            std::vector<frame> stack = {{0, 0, 0, n}};
+            while (!stack.empty()) {
+                frame f = stack.back();
+                stack.pop_back();
+                if (f.d == k) {
+                    m_bounds[2*f.x]   = f.l;
+                    m_bounds[2*f.x+1] = f.r;
+                    continue;
+                }
+                for (uint64_t cc=1; cc <= sigma; ++cc) {
+                    auto ranks = csa.bwt.rank_pair(f.l, f.r, csa.comp2char[cc]);
+                    if (ranks.first < ranks.second) {
+                        stack.push_back({(uint8_t)(f.d+1), f.x+(cc-1)*pow[f.d],
+                                         csa.C[cc]+ranks.first, csa.C[cc]+ranks.second});
+                    }
+                }
+            }
+        }
+
+        //! Length of the tabulated strings; 0 if there is no table.
+        uint8_t k()const
+        {
+            return m_k;
+        }
+
+        //! Looks up the SA interval of the string of length k() starting at begin.
+        /*! \param csa   The CSA for which the table was built.
+         *  \param begin Iterator to the first of k() symbols.
+         *  \param l_res Left border of the interval.
+         *  \param r_res Right border of the interval.
+         *  \return False if a symbol does not occur in the table's alphabet;
+         *          l_res and r_res are unchanged then.
+         */
+        template<class t_csa, class t_pat_iter>
+        bool interval(const t_csa& csa, t_pat_iter begin,
+                      typename t_csa::size_type& l_res, typename t_csa::size_type& r_res)const
+        {
+            uint64_t x = 0;
+            for (uint8_t i=0; i < m_k; ++i, ++begin) {
+                uint64_t cc = csa.char2comp[(typename t_csa::char_type)*begin];
+                if (cc == 0) { // sentinel or symbol which is not in the text
+                    return false;
+                }
+                x = x*m_sigma + cc-1;
+            }
+            l_res = m_bounds[2*x];
+            r_res = m_bounds[2*x+1]-1;
+            return true;
+        }
+
+        void swap(kmer_table& kt)
+        {
+            if (this != &kt) {
+                std::swap(m_k, kt.m_k);
+                std::swap(m_sigma, kt.m_sigma);
+                m_bounds.swap(kt.m_bounds);
+            }
+        }
+
+        //! Serializes the table to a stream; writes nothing if t_k=0.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            if (t_k == 0) {
+                return 0;
+            }
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_k, out, child, "k");
+            written_bytes += write_member(m_sigma, out, child, "sigma");
+            written_bytes += m_bounds.serialize(out, child, "bounds");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in)
+        {
+            if (t_k == 0) {
+                return;
+            }
+            read_member(m_k, in);
+            read_member(m_sigma, in);
+            m_bounds.load(in);
+        }
+};
+
+} // end namespace sdsl
+#endif
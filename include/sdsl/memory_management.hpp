@@ -16,6 +16,8 @@
 #include <set>
 #include <cstddef>
 #include <stack>
+#include <atomic>
+#include <vector>
 #include "config.hpp"
 
 namespace sdsl
@@ -254,10 +256,55 @@ class hugepage_allocator
         }
 };
 
+//! Keeps track of read-only file mappings which back int_vector payloads.
+/*! A mapping stays alive as long as at least one int_vector points into it.
+ *  Files are mapped privately (copy-on-write), so writes to a mapped vector
+ *  never reach the file. One zero page is reserved behind each mapping, since
+ *  rank structures may read the word after the last payload word.
+ */
+class mmap_registry
+{
+    private:
+        struct region {
+            uint8_t* base;
+            size_t   size;   // bytes of the mapping incl. reserved page
+            uint64_t refs;   // number of users of the mapping
+            uint64_t dev;    // device and inode of the mapped file
+            uint64_t ino;
+        };
+        std::mutex          m_mutex;
+        std::vector<region> m_regions;
+        std::atomic<size_t> m_num_regions{0};
+    private:
+        region* find(const void* ptr);
+    public:
+        //! Maps `file` read-only; returns nullptr on failure. The caller holds the first reference.
+        uint8_t* map(const std::string& file, size_t& file_size);
+        //! Checks if ptr lies in one of the mapped files.
+        bool in_address_space(const void* ptr) {
+            if (ptr == nullptr or m_num_regions.load(std::memory_order_relaxed) == 0) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return find(ptr) != nullptr;
+        }
+        //! Checks if `file` is currently mapped.
+        bool maps(const std::string& file);
+        //! Adds a reference to the mapping containing ptr.
+        void acquire(const void* ptr);
+        //! Drops a reference to the mapping containing ptr and unmaps it when unused.
+        void release(const void* ptr);
+        static mmap_registry& the_registry() {
+            static mmap_registry r;
+            return r;
+        }
+};
+
 class memory_manager
 {
     private:
         bool hugepages = false;
+        bool mmap_load = false;
     private:
         static memory_manager& the_manager() {
             static memory_manager m;
@@ -288,14 +335,109 @@ class memory_manager
                 return (uint64_t*) realloc(ptr,size);
             }
         }
+    private:
+        struct mapped_load {
+            const std::istream* in   = nullptr;
+            const uint8_t*      base = nullptr;
+            size_t              size = 0;
+        };
+        static mapped_load& the_mapped_load() {
+            static thread_local mapped_load l;
+            return l;
+        }
+        static std::atomic<uint64_t>& the_mapped_bytes() {
+            static std::atomic<uint64_t> bytes{0};
+            return bytes;
+        }
+        // Drop the reference of a view into a mapped file.
+        template<class t_vec>
+        static void unmap(t_vec& v) {
+            mmap_registry::the_registry().release(v.m_data);
+            the_mapped_bytes() -= ((v.m_size+63)>>6)<<3;
+            v.m_mapped = false;
+        }
+        // Replace a view into a mapped file by a heap copy.
+        template<class t_vec>
+        static void detach(t_vec& v) {
+            size_t payload_bytes = ((v.m_size+63)>>6)<<3;
+            size_t allocated_bytes = (((v.m_size+64)>>6)<<3);
+            uint64_t* data = alloc_mem(allocated_bytes);
+            if (allocated_bytes != 0 && data == nullptr) {
+                throw std::bad_alloc();
+            }
+            memcpy(data, v.m_data, payload_bytes);
+            if (payload_bytes != allocated_bytes) {
+                data[payload_bytes/8] = 0;
+            }
+            unmap(v);
+            v.m_data = data;
+            memory_monitor::record(payload_bytes);
+        }
     public:
         static void use_hugepages(size_t bytes = 0) {
             auto& m = the_manager();
             hugepage_allocator::the_allocator().init(bytes);
             m.hugepages = true;
         }
+        //! Make load_from_file map files instead of reading them into heap memory.
+        /*! All int_vectors loaded afterwards become read-only views into the
+         *  mapped file, as long as their payload is 8-byte aligned in the file.
+         *  Unaligned payloads are copied to the heap as before. A view is
+         *  transparently copied to the heap when the vector is resized.
+         */
+        static void use_mmap_load(bool use = true) {
+            the_manager().mmap_load = use;
+        }
+        static bool mmap_load_enabled() {
+            return the_manager().mmap_load;
+        }
+        //! Serve int_vector payloads read from stream `in` from the mapped file at `base`.
+        static void begin_mapped_load(const std::istream& in, const uint8_t* base, size_t size) {
+            auto& l = the_mapped_load();
+            l.in = &in; l.base = base; l.size = size;
+        }
+        static void end_mapped_load() {
+            the_mapped_load() = mapped_load();
+        }
+        //! Checks if ptr points into a mapped file.
+        /*! This searches the mappings; int_vectors know whether they are mapped.
+         */
+        static bool is_mapped(const void* ptr) {
+            return mmap_registry::the_registry().in_address_space(ptr);
+        }
+        //! Number of payload bytes of all int_vectors which currently view a mapped file.
+        static uint64_t mapped_bytes() {
+            return the_mapped_bytes().load();
+        }
+        //! Let v view the next `size` bits of stream `in` if it belongs to a mapped load.
+        /*! \returns true if v now points into the mapping and `in` was advanced
+         *           past the payload, false if the payload has to be read.
+         */
+        template<class t_vec>
+        static bool map_payload(t_vec& v, const typename t_vec::size_type size, std::istream& in) {
+            auto& l = the_mapped_load();
+            if (l.in != &in) {
+                return false;
+            }
+            std::streamoff offset = in.tellg();
+            uint64_t payload_bytes = ((size+63)>>6)<<3;
+            if (offset < 0 or (offset & 0x7) or offset + payload_bytes > l.size) {
+                return false;
+            }
+            clear(v);
+            v.m_size = size;
+            v.m_data = (uint64_t*)(l.base + offset);
+            v.m_mapped = true;
+            mmap_registry::the_registry().acquire(v.m_data);
+            the_mapped_bytes() += payload_bytes;
+            in.seekg(payload_bytes, std::ios_base::cur);
+            return true;
+        }
         template<class t_vec>
         static void resize(t_vec& v, const typename t_vec::size_type size) {
+            if (v.m_mapped) {
+                detach(v);
+            }
             uint64_t old_size_in_bytes = ((v.m_size+63)>>6)<<3;
             uint64_t new_size_in_bytes = ((size+63)>>6)<<3;
             bool do_realloc = old_size_in_bytes != new_size_in_bytes;
@@ -326,6 +468,11 @@ class memory_manager
         }
         template<class t_vec>
         static void clear(t_vec& v) {
+            if (v.m_mapped) {
+                unmap(v);
+                v.m_data = nullptr;
+                return;
+            }
             int64_t size_in_bytes = ((v.m_size+63)>>6)<<3;
             // remove mem
             memory_manager::free_mem(v.m_data);
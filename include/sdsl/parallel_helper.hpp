@@ -0,0 +1,170 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file parallel_helper.hpp
+    \brief parallel_helper.hpp contains small helper functions to distribute
+           work of the construction algorithms over several threads.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_PARALLEL_HELPER
+#define INCLUDED_SDSL_PARALLEL_HELPER
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace sdsl
+{
+namespace parallel
+{
+
+//! Returns the number of threads which should be used for a task of size n.
+/*! \param num_threads Requested number of threads (0 is treated as 1).
+ *  \param n           Size of the task.
+ *  \param min_chunk   Minimal number of elements processed by one thread.
+ */
+inline uint64_t threads_for(uint64_t num_threads, uint64_t n, uint64_t min_chunk=1)
+{
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    if (min_chunk == 0) {
+        min_chunk = 1;
+    }
+    return std::max((uint64_t)1, std::min(num_threads, n/min_chunk));
+}
+
+//! Runs f(0), ..., f(num_threads-1) concurrently.
+/*! The calling thread executes f(0) and joins the other threads afterwards.
+ */
+template<class t_func>
+void run(uint64_t num_threads, t_func f)
+{
+    if (num_threads <= 1) {
+        f((uint64_t)0);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads-1);
+    for (uint64_t t=1; t < num_threads; ++t) {
+        threads.emplace_back(f, t);
+    }
+    f((uint64_t)0);
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+//! Splits [0..n) into num_threads contiguous ranges and calls f(t, begin, end) for each in parallel.
+template<class t_func>
+void for_each_range(uint64_t num_threads, uint64_t n, t_func f)
+{
+    num_threads = threads_for(num_threads, n);
+    run(num_threads, [&](uint64_t t) {
+        uint64_t begin = (n/num_threads)*t + std::min(t, n%num_threads);
+        uint64_t end   = begin + n/num_threads + (t < n%num_threads);
+        f(t, begin, end);
+    });
+}
+
+//! Calls the tasks concurrently on up to num_threads threads.
+/*! For num_threads <= 1 the tasks are called in order by the calling thread.
+ */
+inline void invoke(uint64_t num_threads, const std::vector<std::function<void()>>& tasks)
+{
+    uint64_t threads = std::min(std::max(num_threads, (uint64_t)1), (uint64_t)tasks.size());
+    run(threads, [&](uint64_t t) {
+        for (uint64_t i=t; i < tasks.size(); i+=threads) {
+            tasks[i]();
+        }
+    });
+}
+
+//! Sets the bits of x[0..len) at bit position idx of data by atomic OR operations.
+/*! Concurrent calls for disjoint bit ranges of a zero-initialized array
+ *  are safe, even if the ranges share a 64-bit word.
+ *  \pre len <= 64 and x < 2^len.
+ */
+inline void atomic_or_bits(uint64_t* data, uint64_t idx, uint64_t x, uint8_t len)
+{
+    uint64_t* word = data + (idx>>6);
+    uint8_t offset = idx&0x3F;
+    __atomic_fetch_or(word, x<<offset, __ATOMIC_RELAXED);
+    if (offset + len > 64) {
+        __atomic_fetch_or(word+1, x>>(64-offset), __ATOMIC_RELAXED);
+    }
+}
+
+//! Sets the bits of x[0..len) at bit position idx of data, where [begin..end) is the bit range of the calling thread.
+/*! Words which lie completely inside [begin..end) belong to the calling
+ *  thread and are written by plain stores. Only the two words at the
+ *  borders of the range, which may be shared with other threads, are
+ *  written by atomic OR operations.
+ *  \pre begin <= idx, idx+len <= end, len <= 64 and x < 2^len.
+ */
+inline void or_bits_in_range(uint64_t* data, uint64_t begin, uint64_t end, uint64_t idx, uint64_t x, uint8_t len)
+{
+    uint64_t w = idx>>6;
+    uint8_t offset = idx&0x3F;
+    if ((w<<6) >= begin and ((idx+len+63)&~0x3FULL) <= end) {
+        data[w] |= x<<offset;
+        if (offset + len > 64) {
+            data[w+1] |= x>>(64-offset);
+        }
+    } else {
+        atomic_or_bits(data, idx, x, len);
+    }
+}
+
+//! Sorts the range [first..last) with up to num_threads threads.
+/*! The range is split into blocks which are sorted concurrently and
+ *  afterwards merged pairwise in \f$\lceil\log num\_threads\rceil\f$ rounds.
+ */
+template<class t_rac_iter, class t_comp>
+void sort(t_rac_iter first, t_rac_iter last, t_comp comp, uint64_t num_threads)
+{
+    uint64_t n = last-first;
+    num_threads = threads_for(num_threads, n, 1<<16);
+    if (num_threads == 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::vector<uint64_t> bounds(num_threads+1, 0);
+    for (uint64_t t=0; t <= num_threads; ++t) {
+        bounds[t] = (n*t)/num_threads;
+    }
+    run(num_threads, [&](uint64_t t) {
+        std::sort(first+bounds[t], first+bounds[t+1], comp);
+    });
+    for (uint64_t step=1; step < num_threads; step*=2) {
+        uint64_t merges = (num_threads+2*step-1)/(2*step);
+        run(merges, [&](uint64_t m) {
+            uint64_t lb = 2*step*m;
+            uint64_t mid = std::min(lb+step, num_threads);
+            uint64_t rb = std::min(lb+2*step, num_threads);
+            if (mid < rb) {
+                std::inplace_merge(first+bounds[lb], first+bounds[mid], first+bounds[rb], comp);
+            }
+        });
+    }
+}
+
+} // end namespace parallel
+} // end namespace sdsl
+
+#endif
@@ -0,0 +1,693 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file pef_vector.hpp
+   \brief pef_vector.hpp contains the sdsl::pef_vector class, and
+          classes which support rank and select for pef_vector.
+   \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_PEF_VECTOR
+#define INCLUDED_SDSL_PEF_VECTOR
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "iterators.hpp"
+
+#include <algorithm>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+template<uint8_t t_b=1, uint32_t t_chunk_size=2048>// forward declaration needed for friend declaration
+class rank_support_pef;  // in pef_vector
+
+template<uint8_t t_b=1, uint32_t t_chunk_size=2048>// forward declaration needed for friend declaration
+class select_support_pef;  // in pef_vector
+
+//! A bit vector which is partitioned into chunks with individual encodings.
+/*!
+ * The original bit_vector is split into chunks of t_chunk_size bits. Each
+ * chunk is stored in the cheapest of four encodings:
+ *  - empty or full: the chunk consists of zeros or ones only and takes no space,
+ *  - plain: the t_chunk_size bits of the chunk,
+ *  - Elias-Fano: the positions of the ones inside the chunk, split into
+ *    \f$\lfloor\log(t\_chunk\_size/m)\rfloor\f$ low bits and unary coded high parts.
+ * For each chunk the number of ones before the chunk and the start of its
+ * encoding are stored. Unlike sd_vector, which splits the positions with one
+ * global width, the encodings adapt to the local density. Clustered bit vectors
+ * therefore need less space.
+ *
+ * \tparam t_chunk_size Number of bits per chunk; a multiple of 64.
+ *
+ * \par References
+ *  - G. Ottaviano, R. Venturini: ,,Partitioned Elias-Fano Indexes'',
+ *    Proceedings of SIGIR 2014. The uniform partition is used here, so the
+ *    chunk of a position is found without search.
+ *
+ * \sa sd_vector, rank_support_pef, select_support_pef
+ */
+template<uint32_t t_chunk_size=2048>
+class pef_vector
+{
+        static_assert(t_chunk_size > 0 and t_chunk_size % 64 == 0, "pef_vector: t_chunk_size has to be a positive multiple of 64.");
+    public:
+        typedef bit_vector::size_type                    size_type;
+        typedef size_type                                value_type;
+        typedef bit_vector::difference_type              difference_type;
+        typedef random_access_const_iterator<pef_vector> iterator;
+        typedef bv_tag                                   index_category;
+
+        friend class rank_support_pef<1, t_chunk_size>;
+        friend class rank_support_pef<0, t_chunk_size>;
+        friend class select_support_pef<1, t_chunk_size>;
+        friend class select_support_pef<0, t_chunk_size>;
+
+        typedef rank_support_pef<1, t_chunk_size>   rank_1_type;
+        typedef rank_support_pef<0, t_chunk_size>   rank_0_type;
+        typedef select_support_pef<1, t_chunk_size> select_1_type;
+        typedef select_support_pef<0, t_chunk_size> select_0_type;
+
+        enum { chunk_size = t_chunk_size };
+        enum chunk_encoding { EMPTY, FULL, PLAIN, EF };
+    private:
+        size_type    m_size = 0;  //!< Size of the original bitvector
+        int_vector<> m_rank;      //!< Number of ones before chunk c; one extra entry for the total
+        int_vector<> m_offset;    //!< Start of the encoding of chunk c in m_data; one extra entry for the end
+        bit_vector   m_data;      //!< Concatenated encodings of the chunks
+
+        //! Description of a chunk.
+        struct chunk_type {
+            size_type off;   // start of the encoding in m_data
+            size_type len;   // number of bits of the original bitvector in the chunk
+            size_type ones;  // number of ones in the chunk
+            uint8_t   enc;   // chunk_encoding
+            uint8_t   wl;    // width of the low parts for EF
+            size_type hoff;  // start of the high parts for EF
+            size_type hs;    // length of the high parts for EF
+        };
+
+        static uint8_t ef_width(size_type len, size_type ones)
+        {
+            return bits::hi(len/ones);
+        }
+
+        static size_type ef_bits(size_type len, size_type ones)
+        {
+            uint8_t wl = ef_width(len, ones);
+            return ones*wl + ones + ((len-1) >> wl) + 1;
+        }
+
+        size_type chunks()const
+        {
+            return m_rank.size()-1;
+        }
+
+        chunk_type chunk(size_type c)const
+        {
+            chunk_type ch;
+            ch.off  = m_offset[c];
+            ch.len  = std::min((size_type)t_chunk_size, m_size - c*t_chunk_size);
+            ch.ones = m_rank[c+1] - m_rank[c];
+            ch.wl = 0; ch.hoff = 0; ch.hs = 0;
+            if (ch.ones == 0) {
+                ch.enc = EMPTY;
+            } else if (ch.ones == ch.len) {
+                ch.enc = FULL;
+            } else if (m_offset[c+1] - ch.off == ch.len) {
+                ch.enc = PLAIN;
+            } else {
+                ch.enc  = EF;
+                ch.wl   = ef_width(ch.len, ch.ones);
+                ch.hoff = ch.off + ch.ones*ch.wl;
+                ch.hs   = m_offset[c+1] - ch.hoff;
+            }
+            return ch;
+        }
+
+        //! Position of the k-th one (or zero) in m_data[start..start+n-1], relative to start.
+        size_type scan_select(size_type start, size_type n, size_type k, bool one)const
+        {
+            for (size_type p=0; p < n; p += 64) {
+                uint8_t len = std::min((size_type)64, n-p);
+                uint64_t w = m_data.get_int(start+p, len);
+                if (!one) {
+                    w = ~w & bits::lo_set[len];
+                }
+                size_type cnt = bits::cnt(w);
+                if (cnt >= k) {
+                    return p + bits::sel(w, k);
+                }
+                k -= cnt;
+            }
+            return n;
+        }
+
+        //! Position of the first one in m_data[start+p..start+n-1] relative to start, or n.
+        size_type scan_next_one(size_type start, size_type n, size_type p)const
+        {
+            while (p < n) {
+                uint8_t len = std::min((size_type)64, n-p);
+                uint64_t w = m_data.get_int(start+p, len);
+                if (w) {
+                    return p + bits::lo(w);
+                }
+                p += len;
+            }
+            return n;
+        }
+
+        //! Number of ones in m_data[start..start+n-1].
+        size_type scan_cnt(size_type start, size_type n)const
+        {
+            size_type res = 0;
+            for (size_type p=0; p < n; p += 64) {
+                res += bits::cnt(m_data.get_int(start+p, std::min((size_type)64, n-p)));
+            }
+            return res;
+        }
+
+        uint64_t ef_low(const chunk_type& ch, size_type r)const
+        {
+            return ch.wl ? m_data.get_int(ch.off + r*ch.wl, ch.wl) : 0;
+        }
+
+        //! Number of ones before position j in an EF chunk and the position of the next one (or len).
+        std::pair<size_type, size_type> ef_lower_bound(const chunk_type& ch, size_type j)const
+        {
+            if (j >= ch.len) {
+                return {ch.ones, ch.len};
+            }
+            size_type h = j >> ch.wl;
+            size_type p = h ? scan_select(ch.hoff, ch.hs, h, false) + 1 : 0;
+            size_type r = p - h;
+            uint64_t val_low = j & bits::lo_set[ch.wl];
+            while (r < ch.ones and m_data[ch.hoff + p] and ef_low(ch, r) < val_low) {
+                ++p; ++r;
+            }
+            if (r == ch.ones) {
+                return {ch.ones, ch.len};
+            }
+            if (!m_data[ch.hoff + p]) {
+                p = scan_next_one(ch.hoff, ch.hs, p);
+            }
+            return {r, ((p - r) << ch.wl) | ef_low(ch, r)};
+        }
+
+        //! Number of ones before position j in chunk ch; j in [0..ch.len].
+        size_type local_rank(const chunk_type& ch, size_type j)const
+        {
+            switch (ch.enc) {
+                case EMPTY: return 0;
+                case FULL:  return j;
+                case PLAIN: return scan_cnt(ch.off, j);
+                default:    return ef_lower_bound(ch, j).first;
+            }
+        }
+
+        //! Position of the first one at or after position j in chunk ch, or ch.len.
+        size_type local_successor(const chunk_type& ch, size_type j)const
+        {
+            switch (ch.enc) {
+                case EMPTY: return ch.len;
+                case FULL:  return j;
+                case PLAIN: return scan_next_one(ch.off, ch.len, j);
+                default:    return ef_lower_bound(ch, j).second;
+            }
+        }
+
+        //! Position of the k-th one in chunk ch; k in [1..ch.ones].
+        size_type local_select1(const chunk_type& ch, size_type k)const
+        {
+            switch (ch.enc) {
+                case FULL:  return k-1;
+                case PLAIN: return scan_select(ch.off, ch.len, k, true);
+                default: {
+                    size_type p = scan_select(ch.hoff, ch.hs, k, true);
+                    return ((p - (k-1)) << ch.wl) | ef_low(ch, k-1);
+                }
+            }
+        }
+
+        //! Position of the k-th zero in chunk ch; k in [1..ch.len-ch.ones].
+        size_type local_select0(const chunk_type& ch, size_type k)const
+        {
+            switch (ch.enc) {
+                case EMPTY: return k-1;
+                case PLAIN: return scan_select(ch.off, ch.len, k, false);
+                default: {
+                    // walk over the ones in increasing order, each one smaller
+                    // than the candidate shifts it by one
+                    size_type pos = k-1;
+                    for (size_type r=0, p=0; r < ch.ones; ++r, ++p) {
+                        p = scan_next_one(ch.hoff, ch.hs, p);
+                        if ((((p - r) << ch.wl) | ef_low(ch, r)) > pos) {
+                            break;
+                        }
+                        ++pos;
+                    }
+                    return pos;
+                }
+            }
+        }
+
+        //! Chunk which contains the k-th one; k in [1..number of ones].
+        size_type chunk_of_one(size_type k)const
+        {
+            return std::lower_bound(m_rank.begin(), m_rank.end(), k) - m_rank.begin() - 1;
+        }
+
+    public:
+        pef_vector() {}
+
+        pef_vector(const bit_vector& bv)
+        {
+            m_size = bv.size();
+            size_type n_chunks = (m_size + t_chunk_size - 1) / t_chunk_size;
+            m_rank   = int_vector<>(n_chunks+1, 0, 64);
+            m_offset = int_vector<>(n_chunks+1, 0, 64);
+            const uint64_t* bvp = bv.data();
+            auto chunk_word = [&](size_type c, size_type w, size_type len) {
+                uint64_t x = bvp[c*(t_chunk_size/64) + w];
+                return (w+1)*64 > len ? x & bits::lo_set[len - w*64] : x;
+            };
+            // (1) count the ones and determine the size of the encodings
+            for (size_type c=0; c < n_chunks; ++c) {
+                size_type len  = std::min((size_type)t_chunk_size, m_size - c*t_chunk_size);
+                size_type ones = 0;
+                for (size_type w=0; w*64 < len; ++w) {
+                    ones += bits::cnt(chunk_word(c, w, len));
+                }
+                size_type enc_bits = 0;
+                if (ones > 0 and ones < len) {
+                    enc_bits = std::min(len, ef_bits(len, ones));
+                }
+                m_rank[c+1]   = m_rank[c] + ones;
+                m_offset[c+1] = m_offset[c] + enc_bits;
+            }
+            m_data = bit_vector(m_offset[n_chunks], 0);
+            // (2) encode the chunks
+            for (size_type c=0; c < n_chunks; ++c) {
+                chunk_type ch = chunk(c);
+                if (ch.enc == PLAIN) {
+                    for (size_type w=0; w*64 < ch.len; ++w) {
+                        uint8_t len = std::min((size_type)64, ch.len - w*64);
+                        m_data.set_int(ch.off + w*64, chunk_word(c, w, ch.len), len);
+                    }
+                } else if (ch.enc == EF) {
+                    for (size_type w=0, r=0; w*64 < ch.len; ++w) {
+                        uint64_t x = chunk_word(c, w, ch.len);
+                        while (x) {
+                            size_type v = w*64 + bits::lo(x);
+                            x &= x-1;
+                            if (ch.wl) {
+                                m_data.set_int(ch.off + r*ch.wl, v & bits::lo_set[ch.wl], ch.wl);
+                            }
+                            m_data[ch.hoff + (v >> ch.wl) + r] = 1;
+                            ++r;
+                        }
+                    }
+                }
+            }
+            util::bit_compress(m_rank);
+            util::bit_compress(m_offset);
+        }
+
+        //! Accessing the i-th element of the original bit_vector
+        /*! \param i An index i with \f$ 0 \leq i < size()  \f$.
+         *  \return The i-th bit of the original bit_vector
+         *  \par Time complexity
+         *     \f$ \Order{t\_chunk\_size/64} \f$
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            size_type c = i / t_chunk_size;
+            chunk_type ch = chunk(c);
+            size_type j = i - c*t_chunk_size;
+            switch (ch.enc) {
+                case EMPTY: return 0;
+                case FULL:  return 1;
+                case PLAIN: return m_data[ch.off + j];
+                default:    return ef_lower_bound(ch, j).second == j;
+            }
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *  \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, uint8_t len=64)const
+        {
+            uint64_t res = 0;
+            for (size_type p = successor(idx); p < idx+len; p = successor(p+1)) {
+                res |= 1ULL << (p-idx);
+            }
+            return res;
+        }
+
+        //! Returns the position of the first one at or after position i.
+        /*! \param i Position in \f$[0..size()]\f$.
+         *  \return The smallest \f$p\geq i\f$ with \f$b[p]=1\f$, or size() if there is none.
+         */
+        size_type successor(size_type i)const
+        {
+            if (i >= m_size) {
+                return m_size;
+            }
+            size_type c = i / t_chunk_size;
+            chunk_type ch = chunk(c);
+            size_type j = local_successor(ch, i - c*t_chunk_size);
+            if (j < ch.len) {
+                return c*t_chunk_size + j;
+            }
+            size_type r = m_rank[c+1];
+            if (r == m_rank[chunks()]) {
+                return m_size;
+            }
+            c = chunk_of_one(r+1);
+            return c*t_chunk_size + local_select1(chunk(c), r+1 - m_rank[c]);
+        }
+
+        //! Returns the position of the last one at or before position i.
+        /*! \param i Position in \f$[0..size()-1]\f$; larger values are treated as size()-1.
+         *  \return The largest \f$p\leq i\f$ with \f$b[p]=1\f$, or size() if there is none.
+         */
+        size_type predecessor(size_type i)const
+        {
+            if (m_size == 0) {
+                return m_size;
+            }
+            i = std::min(i, m_size-1);
+            size_type c = i / t_chunk_size;
+            chunk_type ch = chunk(c);
+            size_type r = local_rank(ch, i - c*t_chunk_size + 1);
+            if (r > 0) {
+                return c*t_chunk_size + local_select1(ch, r);
+            }
+            r = m_rank[c];
+            if (r == 0) {
+                return m_size;
+            }
+            c = chunk_of_one(r);
+            return c*t_chunk_size + local_select1(chunk(c), r - m_rank[c]);
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += m_rank.serialize(out, child, "rank");
+            written_bytes += m_offset.serialize(out, child, "offset");
+            written_bytes += m_data.serialize(out, child, "data");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            m_rank.load(in);
+            m_offset.load(in);
+            m_data.load(in);
+        }
+
+        void swap(pef_vector& bv)
+        {
+            if (this != &bv) {
+                std::swap(m_size, bv.m_size);
+                m_rank.swap(bv.m_rank);
+                m_offset.swap(bv.m_offset);
+                m_data.swap(bv.m_data);
+            }
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, size());
+        }
+};
+
+//! Rank support for pef_vector.
+/*! Adds the number of ones before the chunk of i and the rank inside the chunk.
+ */
+template<uint8_t t_b, uint32_t t_chunk_size>
+class rank_support_pef
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_support_pef only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type      size_type;
+        typedef pef_vector<t_chunk_size>   bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+        size_type rank1(size_type i)const
+        {
+            if (i == m_v->m_size) {
+                return m_v->m_rank[m_v->chunks()];
+            }
+            size_type c = i / t_chunk_size;
+            return m_v->m_rank[c] + m_v->local_rank(m_v->chunk(c), i - c*t_chunk_size);
+        }
+
+    public:
+
+        rank_support_pef(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the number of occurrences of the bit pattern in [0..i-1].
+        size_type rank(size_type i)const
+        {
+            assert(i <= m_v->size());
+            if (t_b) return rank1(i);
+            return i - rank1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        //! Prefetches the chunk ranks and offsets which are accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            size_type c = i / t_chunk_size;  // same chunk as rank1(i)
+            util::prefetch(m_v->m_rank, c);
+            if (c < m_v->chunks()) {
+                util::prefetch(m_v->m_offset, c);
+            }
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_pef::rank(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_pef& operator=(const rank_support_pef& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_pef&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select support for pef_vector.
+/*! The chunk of every sample_rate-th occurrence is sampled. A query
+ *  searches the chunk between two samples by the ranks of the chunks and
+ *  then selects inside the chunk.
+ */
+template<uint8_t t_b, uint32_t t_chunk_size>
+class select_support_pef
+{
+        static_assert(t_b == 1 or t_b == 0 , "select_support_pef only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type      size_type;
+        typedef pef_vector<t_chunk_size>   bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+        enum { sample_rate = 4096 };
+    private:
+        const bit_vector_type* m_v = nullptr;
+        int_vector<> m_samples;  //!< Chunk of the (k*sample_rate+1)-th occurrence, followed by the last chunk
+
+        //! Number of occurrences before chunk c.
+        size_type args_before(size_type c)const
+        {
+            size_type ones = m_v->m_rank[c];
+            return t_b ? ones : c*t_chunk_size - ones;
+        }
+
+    public:
+
+        select_support_pef(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+            if (v == nullptr or v->size() == 0)
+                return;
+            size_type chunks = v->chunks();
+            size_type ones   = v->m_rank[chunks];
+            size_type total  = t_b ? ones : v->size() - ones;
+            size_type sample_cnt = (total+sample_rate-1)/sample_rate;
+            m_samples = int_vector<>(sample_cnt+1, 0, bits::hi(chunks)+1);
+            size_type k = 0, next = 1;
+            for (size_type c=0; c+1 < chunks and k < sample_cnt; ++c) {
+                size_type end = args_before(c+1);
+                while (k < sample_cnt and next <= end) {
+                    m_samples[k++] = c;
+                    next += sample_rate;
+                }
+            }
+            while (k < sample_cnt) {  // occurrences in the last chunk
+                m_samples[k++] = chunks-1;
+            }
+            m_samples[sample_cnt] = chunks-1;
+        }
+
+        //! Returns the position of the i-th occurrence in the bit vector.
+        size_type select(size_type i)const
+        {
+            size_type k  = (i-1)/sample_rate;
+            size_type lb = m_samples[k], rb = m_samples[k+1];
+            // find the last chunk c in [lb..rb] with args_before(c) < i
+            while (lb < rb) {
+                size_type mid = lb + (rb-lb+1)/2;
+                if (args_before(mid) < i) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            i -= args_before(lb);
+            auto ch = m_v->chunk(lb);
+            return lb*t_chunk_size + (t_b ? m_v->local_select1(ch, i) : m_v->local_select0(ch, i));
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        //! Prefetches the samples which are accessed by select(i).
+        void prefetch(size_type i)const
+        {
+            util::prefetch(m_samples, (i-1)/sample_rate);
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_support_pef::select(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_pef& operator=(const select_support_pef& ss)
+        {
+            if (this != &ss) {
+                m_samples = ss.m_samples;
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_pef& ss)
+        {
+            m_samples.swap(ss.m_samples);
+        }
+
+        void load(std::istream& in, const bit_vector_type* v=nullptr)
+        {
+            m_samples.load(in);
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = m_samples.serialize(out, child, "samples");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -139,6 +139,25 @@ class rank_support_v5 : public rank_support
         {
             return rank(idx);
         }
+
+        //! Prefetches the memory which is accessed by rank(idx).
+        void prefetch(size_type idx)const
+        {
+            __builtin_prefetch(m_basic_block.data() + ((idx>>10)&0xFFFFFFFFFFFFFFFEULL));
+            __builtin_prefetch(m_v->data() + (idx>>6));
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_v5::rank(i); });
+        }
         size_type size()const
         {
             return m_v->size();
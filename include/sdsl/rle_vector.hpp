@@ -0,0 +1,525 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file rle_vector.hpp
+   \brief rle_vector.hpp contains the sdsl::rle_vector class, and
+          classes which support rank and select for rle_vector.
+   \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_RLE_VECTOR
+#define INCLUDED_SDSL_RLE_VECTOR
+
+#include "int_vector.hpp"
+#include "sd_vector.hpp"
+#include "util.hpp"
+#include "iterators.hpp"
+
+#include <algorithm>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+template<uint8_t t_b=1, class t_run_vector=sd_vector<>>// forward declaration needed for friend declaration
+class rank_support_rle;  // in rle_vector
+
+template<uint8_t t_b=1, class t_run_vector=sd_vector<>>// forward declaration needed for friend declaration
+class select_support_rle;  // in rle_vector
+
+//! A bit vector which stores the runs of ones of the original bit vector.
+/*!
+ * Let r be the number of runs of ones. The k-th run is described by its
+ * start in the original bit vector and by the number of ones before it.
+ * Both sequences are strictly increasing and are stored in two sparse bit
+ * vectors:
+ *  - starts: size n, marks the first position of each run,
+ *  - ones:   size m, marks the rank of the first one of each run.
+ * The space is therefore proportional to \f$r\log(n/r)\f$ and independent
+ * of the lengths of the runs of ones and zeros.
+ *
+ * \tparam t_run_vector Type of the sparse bit vector for the two sequences.
+ *
+ * \par References
+ *  - V. Mäkinen, G. Navarro: ,,Succinct Suffix Arrays Based on Run-Length
+ *    Encoding'', CPM 2005.
+ *
+ * \sa sd_vector, wt_rlmn, rank_support_rle, select_support_rle
+ */
+template<class t_run_vector=sd_vector<>>
+class rle_vector
+{
+    public:
+        typedef bit_vector::size_type                    size_type;
+        typedef size_type                                value_type;
+        typedef bit_vector::difference_type              difference_type;
+        typedef random_access_const_iterator<rle_vector> iterator;
+        typedef bv_tag                                   index_category;
+        typedef t_run_vector                             run_vector_type;
+
+        friend class rank_support_rle<1, t_run_vector>;
+        friend class rank_support_rle<0, t_run_vector>;
+        friend class select_support_rle<1, t_run_vector>;
+        friend class select_support_rle<0, t_run_vector>;
+
+        typedef rank_support_rle<1, t_run_vector>   rank_1_type;
+        typedef rank_support_rle<0, t_run_vector>   rank_0_type;
+        typedef select_support_rle<1, t_run_vector> select_1_type;
+        typedef select_support_rle<0, t_run_vector> select_0_type;
+    private:
+        typedef typename t_run_vector::rank_1_type   run_rank_type;
+        typedef typename t_run_vector::select_1_type run_select_type;
+
+        size_type       m_size = 0;     //!< Size of the original bitvector
+        size_type       m_ones = 0;     //!< Number of ones in the original bitvector
+        size_type       m_runs = 0;     //!< Number of runs of ones
+        t_run_vector    m_starts;       //!< Marks the first position of each run
+        t_run_vector    m_ones_before;  //!< Marks the number of ones before each run
+        run_rank_type   m_starts_rank;
+        run_select_type m_starts_select;
+        run_rank_type   m_ones_before_rank;
+        run_select_type m_ones_before_select;
+
+        void set_supports()
+        {
+            m_starts_rank.set_vector(&m_starts);
+            m_starts_select.set_vector(&m_starts);
+            m_ones_before_rank.set_vector(&m_ones_before);
+            m_ones_before_select.set_vector(&m_ones_before);
+        }
+
+        void copy(const rle_vector& v)
+        {
+            m_size = v.m_size;
+            m_ones = v.m_ones;
+            m_runs = v.m_runs;
+            m_starts = v.m_starts;
+            m_ones_before = v.m_ones_before;
+            m_starts_rank = v.m_starts_rank;
+            m_starts_select = v.m_starts_select;
+            m_ones_before_rank = v.m_ones_before_rank;
+            m_ones_before_select = v.m_ones_before_select;
+            set_supports();
+        }
+
+        //! First position of run k; k in [1..m_runs].
+        size_type run_start(size_type k)const
+        {
+            return m_starts_select(k);
+        }
+
+        //! Number of ones before run k; k in [1..m_runs+1].
+        size_type ones_before(size_type k)const
+        {
+            return k > m_runs ? m_ones : m_ones_before_select(k);
+        }
+
+        //! Number of ones before position i; i in [0..size()].
+        size_type rank1(size_type i)const
+        {
+            size_type k = m_runs ? m_starts_rank(i) : 0;  // runs starting before i
+            if (k == 0) {
+                return 0;
+            }
+            size_type o = ones_before(k);
+            return o + std::min(i - run_start(k), ones_before(k+1) - o);
+        }
+
+        //! Position of the i-th one; i in [1..m_ones].
+        size_type select1(size_type i)const
+        {
+            size_type k = m_ones_before_rank(i);  // runs starting before the i-th one
+            return run_start(k) + (i - 1 - ones_before(k));
+        }
+
+        //! Position of the i-th zero; i in [1..size()-m_ones].
+        size_type select0(size_type i)const
+        {
+            // binary search for the last run k with less than i zeros before it
+            size_type lb = 0, rb = m_runs;
+            while (lb < rb) {
+                size_type mid = lb + (rb-lb+1)/2;
+                if (run_start(mid) - ones_before(mid) < i) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            return (i - 1) + (lb ? ones_before(lb+1) : 0);
+        }
+
+    public:
+        rle_vector() {}
+
+        rle_vector(const rle_vector& v)
+        {
+            copy(v);
+        }
+
+        rle_vector(rle_vector&& v)
+        {
+            *this = std::move(v);
+        }
+
+        rle_vector(const bit_vector& bv)
+        {
+            m_size = bv.size();
+            m_ones = util::cnt_one_bits(bv);
+            // position of the first bit equal to b at or after position i, or m_size
+            auto next_bit = [&](size_type i, bool b) {
+                while (i < m_size) {
+                    uint8_t len = std::min((size_type)64, m_size - i);
+                    uint64_t w = bv.get_int(i, len);
+                    if (!b) {
+                        w = ~w & bits::lo_set[len];
+                    }
+                    if (w) {
+                        return i + bits::lo(w);
+                    }
+                    i += len;
+                }
+                return m_size;
+            };
+            bit_vector starts(m_size, 0);
+            bit_vector ones_before(m_ones, 0);
+            for (size_type i = next_bit(0, 1), o = 0; i < m_size; i = next_bit(i, 1)) {
+                size_type end = next_bit(i, 0);
+                starts[i] = 1;
+                ones_before[o] = 1;
+                o += end - i;
+                i = end;
+                ++m_runs;
+            }
+            if (m_runs > 0) {
+                m_starts = t_run_vector(starts);
+                m_ones_before = t_run_vector(ones_before);
+            }
+            set_supports();
+        }
+
+        //! Accessing the i-th element of the original bit_vector
+        /*! \param i An index i with \f$ 0 \leq i < size()  \f$.
+         *  \return The i-th bit of the original bit_vector
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            size_type k = m_runs ? m_starts_rank(i+1) : 0;  // runs starting at or before i
+            if (k == 0) {
+                return 0;
+            }
+            return i - run_start(k) < ones_before(k+1) - ones_before(k);
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *  \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, uint8_t len=64)const
+        {
+            uint64_t res = 0;
+            if (m_runs == 0) {
+                return res;
+            }
+            size_type k = std::max(m_starts_rank(idx+1), (size_type)1);
+            for (; k <= m_runs; ++k) {
+                size_type s = run_start(k);
+                if (s >= idx+len) {
+                    break;
+                }
+                size_type e  = s + ones_before(k+1) - ones_before(k);
+                size_type lo = std::max(s, idx), hi = std::min(e, idx+len);
+                if (lo < hi) {
+                    res |= bits::lo_set[hi-lo] << (lo-idx);
+                }
+            }
+            return res;
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Returns the number of runs of ones.
+        size_type runs()const
+        {
+            return m_runs;
+        }
+
+        rle_vector& operator=(const rle_vector& v)
+        {
+            if (this != &v) {
+                copy(v);
+            }
+            return *this;
+        }
+
+        rle_vector& operator=(rle_vector&& v)
+        {
+            if (this != &v) {
+                m_size = v.m_size;
+                m_ones = v.m_ones;
+                m_runs = v.m_runs;
+                m_starts = std::move(v.m_starts);
+                m_ones_before = std::move(v.m_ones_before);
+                m_starts_rank = std::move(v.m_starts_rank);
+                m_starts_select = std::move(v.m_starts_select);
+                m_ones_before_rank = std::move(v.m_ones_before_rank);
+                m_ones_before_select = std::move(v.m_ones_before_select);
+                set_supports();
+            }
+            return *this;
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_ones, out, child, "ones");
+            written_bytes += write_member(m_runs, out, child, "runs");
+            written_bytes += m_starts.serialize(out, child, "starts");
+            written_bytes += m_ones_before.serialize(out, child, "ones_before");
+            written_bytes += m_starts_rank.serialize(out, child, "starts_rank");
+            written_bytes += m_starts_select.serialize(out, child, "starts_select");
+            written_bytes += m_ones_before_rank.serialize(out, child, "ones_before_rank");
+            written_bytes += m_ones_before_select.serialize(out, child, "ones_before_select");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_ones, in);
+            read_member(m_runs, in);
+            m_starts.load(in);
+            m_ones_before.load(in);
+            m_starts_rank.load(in, &m_starts);
+            m_starts_select.load(in, &m_starts);
+            m_ones_before_rank.load(in, &m_ones_before);
+            m_ones_before_select.load(in, &m_ones_before);
+        }
+
+        void swap(rle_vector& v)
+        {
+            if (this != &v) {
+                std::swap(m_size, v.m_size);
+                std::swap(m_ones, v.m_ones);
+                std::swap(m_runs, v.m_runs);
+                m_starts.swap(v.m_starts);
+                m_ones_before.swap(v.m_ones_before);
+                util::swap_support(m_starts_rank, v.m_starts_rank, &m_starts, &v.m_starts);
+                util::swap_support(m_starts_select, v.m_starts_select, &m_starts, &v.m_starts);
+                util::swap_support(m_ones_before_rank, v.m_ones_before_rank, &m_ones_before, &v.m_ones_before);
+                util::swap_support(m_ones_before_select, v.m_ones_before_select, &m_ones_before, &v.m_ones_before);
+            }
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, size());
+        }
+};
+
+//! Rank support for rle_vector.
+/*! Finds the last run which starts before i and adds the ones of this run
+ *  which lie before i to the number of ones before the run.
+ */
+template<uint8_t t_b, class t_run_vector>
+class rank_support_rle
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_support_rle only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type    size_type;
+        typedef rle_vector<t_run_vector> bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+
+        rank_support_rle(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the number of occurrences of the bit pattern in [0..i-1].
+        size_type rank(size_type i)const
+        {
+            assert(i <= m_v->size());
+            if (t_b) return m_v->rank1(i);
+            return i - m_v->rank1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        //! Prefetches the memory of the run starts which is accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            if (m_v->m_runs) {
+                m_v->m_starts_rank.prefetch(i);
+            }
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_rle::rank(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_rle& operator=(const rank_support_rle& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_rle&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select support for rle_vector.
+/*! A one is selected by a rank query on the number of ones before each
+ *  run. A zero is selected by a binary search over the runs, like
+ *  select_0 of sd_vector.
+ */
+template<uint8_t t_b, class t_run_vector>
+class select_support_rle
+{
+        static_assert(t_b == 1 or t_b == 0 , "select_support_rle only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type    size_type;
+        typedef rle_vector<t_run_vector> bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+
+        select_support_rle(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the position of the i-th occurrence in the bit vector.
+        size_type select(size_type i)const
+        {
+            if (t_b) return m_v->select1(i);
+            return m_v->select0(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        //! Prefetches the memory which is accessed by select(i) for t_b=1.
+        void prefetch(size_type i)const
+        {
+            if (t_b) {
+                m_v->m_ones_before_rank.prefetch(i);
+            }
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_support_rle::select(i); });
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_rle& operator=(const select_support_rle& ss)
+        {
+            if (this != &ss) {
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_rle&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -484,6 +484,28 @@ class rank_support_rrr
             return rank(i);
         }
 
+        //! Prefetches the samples and block types which are accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            size_type sample_pos = (i/t_bs)/t_k;
+            util::prefetch(m_v->m_rank, sample_pos);
+            util::prefetch(m_v->m_btnrp, sample_pos);
+            util::prefetch(m_v->m_invert, sample_pos);
+            util::prefetch(m_v->m_bt, sample_pos*t_k);
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_rrr::rank(i); });
+        }
+
         //! Returns the size of the original vector
         const size_type size()const
         {
@@ -644,6 +666,16 @@ class select_support_rrr
             return select(i);
         }
 
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The block is found by binary search over the rank samples, so the queries are not prefetched.
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            for (size_t j=0; j < n; ++j) {
+                out[j] = select(args[j]);
+            }
+        }
+
         const size_type size()const
         {
             return m_v->size();
@@ -278,6 +278,208 @@ class sd_vector
             }
         }
 
+    private:
+        //! Position of the (r+1)-th one in m_high, which lies at or after position pos.
+        /*! The two words from pos on are scanned, further ones are found by select.
+         */
+        size_type next_one(size_type pos, size_type r)const
+        {
+            for (uint8_t k=0; k < 2 and pos < m_high.size(); ++k) {
+                uint8_t len = std::min((size_type)64, m_high.size()-pos);
+                uint64_t w = m_high.get_int(pos, len);
+                if (w) {
+                    return pos + bits::lo(w);
+                }
+                pos += len;
+            }
+            return m_high_1_select(r+1);
+        }
+
+        //! Position of the r-th one in m_high, which lies before position pos.
+        size_type prev_one(size_type pos, size_type r)const
+        {
+            for (uint8_t k=0; k < 2 and pos > 0; ++k) {
+                uint8_t len = std::min((size_type)64, pos);
+                uint64_t w = m_high.get_int(pos-len, len);
+                if (w) {
+                    return pos - len + bits::hi(w);
+                }
+                pos -= len;
+            }
+            return m_high_1_select(r);
+        }
+
+        //! Position of the k-th zero in m_high at or after position pos; the h-th zero overall.
+        size_type next_zero(size_type pos, size_type k, size_type h)const
+        {
+            for (uint8_t j=0; j < 4 and pos < m_high.size(); ++j) {
+                uint8_t len = std::min((size_type)64, m_high.size()-pos);
+                uint64_t w = ~m_high.get_int(pos, len) & bits::lo_set[len];
+                uint64_t zeros = bits::cnt(w);
+                if (zeros >= k) {
+                    return pos + bits::sel(w, k);
+                }
+                k -= zeros;
+                pos += len;
+            }
+            return m_high_0_select(h);
+        }
+
+        //! Returns the first one with a value >= x.
+        /*! \param x   The searched value; x < size().
+         *  \param pos Position in m_high at or before the first one of bucket x>>wl
+         *             and after all ones smaller than x.
+         *  \param r   Number of ones before pos.
+         *  pos and r are set to the found one, r equals the number of ones if there is none.
+         */
+        size_type seek(size_type x, size_type& pos, size_type& r)const
+        {
+            const size_type m = m_low.size();
+            const size_type val_low = x & bits::lo_set[m_wl];
+            while (r < m and m_high[pos] and m_low[r] < val_low) {
+                ++pos; ++r;
+            }
+            if (r == m) {
+                return m_size;
+            }
+            if (!m_high[pos]) {
+                pos = next_one(pos, r);
+            }
+            return ((pos - r) << m_wl) | m_low[r];
+        }
+
+    public:
+        //! Returns the position of the first one at or after position i.
+        /*! \param i Position in \f$[0..size()]\f$.
+         *  \return The smallest \f$p\geq i\f$ with \f$b[p]=1\f$, or size() if there is none.
+         *  \par Time complexity
+         *       \f$ \Order{t_{select0} + n/m} \f$ and only one select in the usual case,
+         *       while rank(i) followed by select(rank+1) needs two.
+         */
+        size_type successor(size_type i)const
+        {
+            if (i >= m_size or m_low.size() == 0) {
+                return m_size;
+            }
+            size_type h   = i >> m_wl;
+            size_type pos = h ? m_high_0_select(h) + 1 : 0;
+            size_type r   = pos - h;
+            return seek(i, pos, r);
+        }
+
+        //! Returns the position of the last one at or before position i.
+        /*! \param i Position in \f$[0..size()-1]\f$; larger values are treated as size()-1.
+         *  \return The largest \f$p\leq i\f$ with \f$b[p]=1\f$, or size() if there is none.
+         */
+        size_type predecessor(size_type i)const
+        {
+            if (m_low.size() == 0) {
+                return m_size;
+            }
+            i = std::min(i, m_size-1);
+            size_type h   = i >> m_wl;
+            size_type pos = m_high_0_select(h + 1); // end of bucket h
+            size_type r   = pos - h;                 // ones in buckets [0..h]
+            size_type val_low = i & bits::lo_set[m_wl];
+            while (r > 0 and m_high[pos-1] and m_low[r-1] > val_low) {
+                --pos; --r;
+            }
+            if (r == 0) {
+                return m_size;
+            }
+            if (!m_high[pos-1]) {
+                pos = prev_one(pos, r) + 1;
+            }
+            return ((pos - r) << m_wl) | m_low[r-1];
+        }
+
+        //! Forward cursor over the ones of an sd_vector.
+        /*! Intended for the intersection of sets represented as sd_vectors:
+         *  next() decodes the next one from the high part and next_geq(x)
+         *  skips the buckets before x. Up to 16 buckets are skipped by
+         *  counting the zeros in the words of the high part, more by select_0.
+         */
+        class cursor
+        {
+            private:
+                const sd_vector* m_v = nullptr;
+                size_type m_pos = 0; // position of the current one in high
+                size_type m_r   = 0; // number of ones before the current one
+                size_type m_val = 0; // current value; size() at the end
+
+            public:
+                cursor() = default;
+
+                //! Creates a cursor at successor(i).
+                cursor(const sd_vector& v, size_type i=0) : m_v(&v)
+                {
+                    m_r = v.m_low.size();
+                    m_val = v.m_size;
+                    if (i < v.m_size and v.m_low.size() > 0) {
+                        size_type h = i >> v.m_wl;
+                        m_pos = h ? v.m_high_0_select(h) + 1 : 0;
+                        m_r   = m_pos - h;
+                        m_val = v.seek(i, m_pos, m_r);
+                    }
+                }
+
+                //! Position of the current one, or size() at the end.
+                size_type value()const
+                {
+                    return m_val;
+                }
+
+                //! Number of ones before the current one.
+                size_type rank()const
+                {
+                    return m_r;
+                }
+
+                //! True if the cursor passed the last one.
+                bool end()const
+                {
+                    return m_r >= m_v->m_low.size();
+                }
+
+                //! Moves to the next one.
+                void next()
+                {
+                    if (end()) {
+                        return;
+                    }
+                    if (++m_r == m_v->m_low.size()) {
+                        m_val = m_v->m_size;
+                        return;
+                    }
+                    m_pos = m_v->next_one(m_pos+1, m_r);
+                    m_val = ((m_pos - m_r) << m_v->m_wl) | m_v->m_low[m_r];
+                }
+
+                //! Moves to the first one at or after position x; does not move backwards.
+                void next_geq(size_type x)
+                {
+                    if (end() or x <= m_val) {
+                        return;
+                    }
+                    if (x >= m_v->m_size) {
+                        m_r   = m_v->m_low.size();
+                        m_val = m_v->m_size;
+                        return;
+                    }
+                    size_type h = x >> m_v->m_wl;
+                    size_type cur_h = m_pos - m_r;
+                    if (h > cur_h) {
+                        if (h - cur_h <= 16) {
+                            m_pos = m_v->next_zero(m_pos, h - cur_h, h) + 1;
+                        } else {
+                            m_pos = m_v->m_high_0_select(h) + 1;
+                        }
+                        m_r   = m_pos - h;
+                    }
+                    m_val = m_v->seek(x, m_pos, m_r);
+                }
+        };
+
         //! Swap method
         void swap(sd_vector& v)
         {
@@ -427,6 +629,24 @@ class rank_support_sd
             return rank(i);
         }
 
+        //! Prefetches the select samples of the high part which are accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            m_v->high_0_select.prefetch((i >> (m_v->wl)) + 1);
+        }
+
+        //! Answers the rank queries for positions[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void rank(const uint64_t* positions, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(positions, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return rank_support_sd::rank(i); });
+        }
+
         size_type size()const
         {
             return m_v->size();
@@ -532,6 +752,27 @@ class select_support_sd
             return select(i);
         }
 
+        //! Prefetches the memory which is accessed by select(i) for t_b=1.
+        void prefetch(size_type i)const
+        {
+            if (t_b) {
+                util::prefetch(m_v->low, i-1);
+                m_v->high_1_select.prefetch(i);
+            }
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_support_sd::select(i); });
+        }
+
         size_type size()const
         {
             return m_v->size();
@@ -705,6 +946,26 @@ class select_0_support_sd
             return select(i);
         }
 
+        //! Prefetches the samples which are accessed by select(i).
+        void prefetch(size_type i)const
+        {
+            const size_type bs = 1ULL << (m_v->wl);
+            util::prefetch(m_pointer, (i-1)/(64*bs));
+            util::prefetch(m_rank1, (i-1)/(64*bs));
+        }
+
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const
+        {
+            util::batch_queries(args, n, out,
+                                [this](size_type i) { prefetch(i); },
+                                [this](size_type i) { return select_0_support_sd::select(i); });
+        }
+
         size_type size()const
         {
             return m_v->size();
@@ -96,6 +96,14 @@ class select_support_mcl : public select_support
         inline size_type select(size_type i) const;
         //! Alias for select(i).
         inline size_type operator()(size_type i)const;
+        //! Prefetches the samples which are accessed by select(i).
+        void prefetch(size_type i)const;
+        //! Answers the select queries for args[0..n-1] and writes the results to out[0..n-1].
+        /*! The queries are interleaved with prefetches, so the cache misses
+         *  of several queries overlap.
+         *  \sa util::batch_queries
+         */
+        void select(const uint64_t* args, size_t n, uint64_t* out)const;
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const;
         void load(std::istream& in, const bit_vector* v=nullptr);
         void set_vector(const bit_vector* v=nullptr);
@@ -404,6 +412,24 @@ inline auto select_support_mcl<t_b,t_pat_len>::operator()(size_type i)const -> s
     return select(i);
 }
 
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_mcl<t_b,t_pat_len>::prefetch(size_type i)const
+{
+    size_type sb_idx = (i-1)>>12;
+    util::prefetch(m_superblock, sb_idx);
+    if (m_miniblock != nullptr and m_miniblock[sb_idx].size() > 0) {
+        util::prefetch(m_miniblock[sb_idx], ((i-1)&0xFFF)>>6);
+    }
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_mcl<t_b,t_pat_len>::select(const uint64_t* args, size_t n, uint64_t* out)const
+{
+    util::batch_queries(args, n, out,
+                        [this](size_type i) { prefetch(i); },
+                        [this](size_type i) { return select_support_mcl::select(i); });
+}
+
 template<uint8_t t_b, uint8_t t_pat_len>
 void select_support_mcl<t_b,t_pat_len>::initData()
 {
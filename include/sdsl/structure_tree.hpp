@@ -27,6 +27,7 @@ class structure_tree_node
         size_t              size = 0;
         std::string         name;
         std::string         type;
+        structure_tree_node* parent = nullptr;
     public:
         structure_tree_node(const std::string& n, const std::string& t) : name(n) , type(t) {}
         structure_tree_node* add_child(const std::string& n, const std::string& t) {
@@ -35,6 +36,7 @@ class structure_tree_node
             if (child_itr == m_children.end()) {
                 // add new child as we don't have one of this type yet
                 structure_tree_node* new_node = new structure_tree_node(n,t);
+                new_node->parent = this;
                 m_children[hash] = std::unique_ptr<structure_tree_node>(new_node);
                 return new_node;
             } else {
@@ -22,7 +22,11 @@
 #define INCLUDED_SDSL_SUFFIX_ARRAY_ALGORITHM
 
 #include <iterator>
+#include <vector>
+#include <algorithm>
 #include "suffix_array_helper.hpp"
+#include "parallel_helper.hpp"
+#include "text_sample.hpp"
 
 namespace sdsl
 {
@@ -176,8 +180,9 @@ typename t_csa::size_type backward_search(
 {
     assert(l <= r); assert(r < csa.size());
     typename t_csa::size_type c_begin = csa.C[csa.char2comp[c]];
-    l_res = c_begin + csa.bwt.rank(l, c); // count c in bwt[0..l-1]
-    r_res = c_begin + csa.bwt.rank(r+1, c) - 1; // count c in bwt[0..r]
+    auto ranks = csa.bwt.rank_pair(l, r+1, c); // count c in bwt[0..l-1] and bwt[0..r]
+    l_res = c_begin + ranks.first;
+    r_res = c_begin + ranks.second - 1;
     assert(r_res+1-l_res >= 0);
     return r_res+1-l_res;
 }
@@ -200,6 +205,9 @@ typename t_csa::size_type backward_search(
  *
  * \pre \f$ 0 \leq \ell \leq r < csa.size() \f$
  *
+ * If the search starts with the whole SA and the CSA carries a k-mer table
+ * (see kmer_table), the interval of the last k symbols is looked up.
+ *
  * \par Time complexity
  *       \f$ \Order{ len \cdot t_{rank\_bwt} } \f$
  * \par Reference
@@ -221,6 +229,13 @@ backward_search(
 )
 {
     t_pat_iter it = end;
+    // the k-mer table replaces the first k steps of a search in the whole SA
+    uint8_t k = csa.kmers.k();
+    if (k > 0 and l == 0 and r+1 == csa.size() and end-begin >= k) {
+        if (csa.kmers.interval(csa, end-k, l, r)) {
+            it = end-k;
+        }
+    }
     while (begin < it and r+1-l > 0) {
         --it;
         backward_search(csa, l, r, (typename t_csa::char_type)*it, l, r);
@@ -249,9 +264,9 @@ backward_search(
  *         Bidirectional search in a string with wavelet trees and bidirectional matching statistics.
  *         Inf. Comput. 213: 13-22
  */
-template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
 typename csa_wt<t_wt>::size_type bidirectional_search(
-    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_fwd,
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa_fwd,
     typename csa_wt<>::size_type l_fwd,
     typename csa_wt<>::size_type r_fwd,
     typename csa_wt<>::size_type l_bwd,
@@ -265,7 +280,7 @@ typename csa_wt<t_wt>::size_type bidirectional_search(
 )
 {
     assert(l_fwd <= r_fwd); assert(r_fwd < csa_fwd.size());
-    typedef typename csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type size_type;
+    typedef typename csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>::size_type size_type;
     size_type c_begin = csa_fwd.C[csa_fwd.char2comp[c]];
     auto r_s_b =  csa_fwd.wavelet_tree.lex_count(l_fwd, r_fwd+1, c);
     size_type rank_l = std::get<0>(r_s_b);
@@ -310,10 +325,10 @@ typename csa_wt<t_wt>::size_type bidirectional_search(
  *         Bidirectional search in a string with wavelet trees and bidirectional matching statistics.
  *         Inf. Comput. 213: 13-22
  */
-template<class t_pat_iter, class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+template<class t_pat_iter, class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_kmer_table>
 typename csa_wt<>::size_type bidirectional_search_backward(
-    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_fwd,
-    SDSL_UNUSED const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_bwd,
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa_fwd,
+    SDSL_UNUSED const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa_bwd,
     typename csa_wt<>::size_type l_fwd,
     typename csa_wt<>::size_type r_fwd,
     typename csa_wt<>::size_type l_bwd,
@@ -375,11 +390,12 @@ template<class t_pat_iter,
          uint32_t t_inv_dens,
          class t_sa_sample_strat,
          class t_isa,
-         class t_alphabet_strat>
+         class t_alphabet_strat,
+         class t_kmer_table>
 typename csa_wt<t_wt>::size_type
 bidirectional_search_forward(
-    SDSL_UNUSED const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_fwd,
-    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_bwd,
+    SDSL_UNUSED const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa_fwd,
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat, t_kmer_table>& csa_bwd,
     typename csa_wt<>::size_type l_fwd,
     typename csa_wt<>::size_type r_fwd,
     typename csa_wt<>::size_type l_bwd,
@@ -467,6 +483,132 @@ typename t_csx::size_type count(
     return count(csx, pat.begin(), pat.end(), tag);
 }
 
+//! Number of patterns which are searched in lock-step by backward_search_batch.
+const uint64_t batch_search_group = 16;
+
+//! Backward search for a batch of patterns.
+/*!
+ * \tparam t_csa     CSA type.
+ * \tparam t_pat_rac Random access container of patterns. Each pattern is
+ *                   a random access container of symbols (e.g. string_type).
+ *
+ * \param csa      The CSA object.
+ * \param patterns The patterns.
+ * \return Vector which contains for each pattern patterns[k] its SA interval
+ *         \f$[\ell_k..r_k]\f$ as pair \f$(\ell_k, r_k)\f$. The interval of a pattern
+ *         which does not occur is empty, i.e. \f$r_k+1 = \ell_k\f$.
+ *
+ * A group of batch_search_group patterns is searched in lock-step: the
+ * backward search steps of the group are issued round-robin, and after each
+ * step the memory of the next step of the same pattern is prefetched (see
+ * prefetch_rank of the BWT). The step is done batch_search_group steps later,
+ * so the cache misses of the patterns in the group overlap. A pattern which
+ * is finished is replaced by the next pattern of the batch.
+ *
+ * \par Time complexity
+ *      \f$ \Order{ m \cdot t_{rank\_bwt} } \f$, where \f$m\f$ is the
+ *      total length of the patterns.
+ */
+template<class t_csa, class t_pat_rac>
+std::vector<std::pair<typename t_csa::size_type, typename t_csa::size_type>>
+        backward_search_batch(
+            const t_csa& csa,
+            const t_pat_rac& patterns,
+            SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+        )
+{
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::char_type char_type;
+    size_type m = patterns.size();
+    std::vector<std::pair<size_type, size_type>> res(m, {0, csa.size()-1});
+    if (m == 0 or csa.size() == 0) {
+        return res;
+    }
+    struct search {
+        size_type k;  // index of the pattern
+        size_type d;  // number of symbols which are not processed yet
+        size_type l, r;
+    };
+    // starts the search of the next pattern which needs a backward search step
+    size_type next = 0;
+    uint8_t kmer_k = csa.kmers.k();
+    auto start = [&](search& s) -> bool {
+        while (next < m) {
+            s.k = next++;
+            s.d = patterns[s.k].size();
+            s.l = 0;
+            s.r = csa.size()-1;
+            // the k-mer table replaces the first k steps, as in backward_search
+            if (kmer_k > 0 and s.d >= kmer_k and
+                csa.kmers.interval(csa, patterns[s.k].begin()+(s.d-kmer_k), s.l, s.r)) {
+                s.d -= kmer_k;
+            }
+            if (s.d > 0 and s.r+1-s.l > 0) {
+                return true;
+            }
+            res[s.k] = {s.l, s.r};
+        }
+        return false;
+    };
+    auto prefetch = [&csa](const search& s) {
+        csa.bwt.prefetch_rank(s.l);
+        csa.bwt.prefetch_rank(s.r+1);
+    };
+    std::vector<search> group;
+    for (search s; group.size() < batch_search_group and start(s);) {
+        prefetch(s);
+        group.push_back(s);
+    }
+    size_type j = 0;
+    while (!group.empty()) {
+        search& s = group[j];
+        --s.d;
+        backward_search(csa, s.l, s.r, (char_type)patterns[s.k][s.d], s.l, s.r);
+        if (s.d == 0 or s.r+1-s.l == 0) {
+            res[s.k] = {s.l, s.r};
+            if (!start(s)) {
+                // the last search moves to slot j, its step is due now
+                s = group.back();
+                group.pop_back();
+                if (j >= group.size()) {
+                    j = 0;
+                }
+                continue;
+            }
+        }
+        prefetch(s);
+        if (++j >= group.size()) {
+            j = 0;
+        }
+    }
+    return res;
+}
+
+//! Counts the number of occurrences of each pattern of a batch in a CSA.
+/*!
+ * \tparam t_csa     CSA type.
+ * \tparam t_pat_rac Random access container of patterns.
+ *
+ * \param csa      The CSA object.
+ * \param patterns The patterns.
+ * \return Vector which contains the number of occurrences of patterns[k] at position k.
+ * \sa backward_search_batch
+ */
+template<class t_csa, class t_pat_rac>
+std::vector<typename t_csa::size_type> count_batch(
+    const t_csa& csa,
+    const t_pat_rac& patterns,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    auto intervals = backward_search_batch(csa, patterns);
+    std::vector<typename t_csa::size_type> res(intervals.size());
+    for (size_t k=0; k < intervals.size(); ++k) {
+        res[k] = intervals[k].second+1-intervals[k].first;
+    }
+    return res;
+}
+
 //! Calculates all occurrences of a pattern pat in a CSA.
 /*!
  * \tparam t_csa      CSA type.
@@ -522,6 +664,147 @@ t_rac locate(
     return locate<t_csx, decltype(pat.begin()), t_rac>(csx, pat.begin(), pat.end(), tag);
 }
 
+//! Number of walks which locate_interval advances in lock-step per thread.
+const uint64_t locate_lockstep_walks = 32;
+
+// Calculates out[j-l] = SA[j] for j in [b..e) with locate_lockstep_walks
+// concurrent walks. Each walk applies step until it reaches a sampled
+// position and then combines the sample with the number of steps.
+template<class t_csa, class t_step, class t_value>
+void _locate_lockstep(const t_csa& csa, typename t_csa::size_type l,
+                      typename t_csa::size_type b, typename t_csa::size_type e,
+                      uint64_t* out, t_step step, t_value value)
+{
+    typedef typename t_csa::size_type size_type;
+    struct walk {
+        size_type i;   // current SA position
+        size_type j;   // SA position which is located
+        size_type off; // number of steps so far
+    };
+    walk w[locate_lockstep_walks];
+    size_type cnt = 0;
+    for (; b < e and cnt < locate_lockstep_walks; ++b) {
+        w[cnt++] = {b, b, 0};
+    }
+    // the steps of different walks are independent, so the
+    // cache misses of one round overlap
+    while (cnt > 0) {
+        for (size_type k=0; k < cnt;) {
+            if (csa.sa_sample.is_sampled(w[k].i)) {
+                out[w[k].j-l] = value(csa.sa_sample[w[k].i], w[k].off);
+                if (b < e) {
+                    w[k++] = {b, b, 0};
+                    ++b;
+                } else {
+                    w[k] = w[--cnt];
+                }
+            } else {
+                w[k].i = step(w[k].i);
+                ++w[k].off;
+                ++k;
+            }
+        }
+    }
+}
+
+template<class t_csa>
+void _locate_lockstep(const t_csa& csa, typename t_csa::size_type l,
+                      typename t_csa::size_type b, typename t_csa::size_type e,
+                      uint64_t* out, lf_tag)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type n = csa.size();
+    _locate_lockstep(csa, l, b, e, out,
+    [&csa](size_type i) { return csa.lf[i]; },
+    [n](size_type s, size_type off) { return s+off < n ? s+off : s+off-n; });
+}
+
+template<class t_csa>
+void _locate_lockstep(const t_csa& csa, typename t_csa::size_type l,
+                      typename t_csa::size_type b, typename t_csa::size_type e,
+                      uint64_t* out, psi_tag)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type n = csa.size();
+    _locate_lockstep(csa, l, b, e, out,
+    [&csa](size_type i) { return csa.psi[i]; },
+    [n](size_type s, size_type off) { return s < off ? n-(off-s) : s-off; });
+}
+
+//! Calculates the suffix array values SA[l..r].
+/*!
+ * \tparam t_csa CSA type.
+ *
+ * \param csa         The CSA object.
+ * \param l           Left border of the interval.
+ * \param r           Right border of the interval.
+ * \param out         Buffer which receives out[j-l] = SA[j] for \f$j\in[l..r]\f$.
+ * \param num_threads Number of threads.
+ *
+ * Each value is found by a walk over LF (or \f$\Psi\f$ for \f$\Psi\f$-based
+ * CSAs) until a sampled position is reached, as in operator[]. The walks
+ * of locate_lockstep_walks positions are advanced in lock-step, so the
+ * cache misses of different walks overlap instead of being paid one after
+ * another. The interval is split into contiguous parts for the threads.
+ *
+ * \pre \f$ l \leq r < csa.size() \f$
+ * \par Time complexity
+ *      \f$ \Order{ (r-l+1) \cdot t_{SA} / num\_threads } \f$
+ */
+template<class t_csa>
+void locate_interval(
+    const t_csa& csa,
+    typename t_csa::size_type l,
+    typename t_csa::size_type r,
+    uint64_t* out,
+    uint64_t num_threads=1,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    assert(l <= r); assert(r < csa.size());
+    typename t_csa::size_type n = r+1-l;
+    num_threads = parallel::threads_for(num_threads, n, 1<<12);
+    parallel::for_each_range(num_threads, n, [&](uint64_t, uint64_t b, uint64_t e) {
+        typename t_csa::extract_category tag;
+        _locate_lockstep(csa, l, l+b, l+e, out, tag);
+    });
+}
+
+//! Calculates the occurrences of a pattern in a CSA and writes them to a buffer.
+/*!
+ * \tparam t_csa      CSA type.
+ * \tparam t_pat_iter Pattern iterator type.
+ *
+ * \param csa         The CSA object.
+ * \param begin       Iterator to the begin of the pattern (inclusive).
+ * \param end         Iterator to the end of the pattern (exclusive).
+ * \param occ         Buffer for the occurrences.
+ * \param max_occ     Capacity of occ. Only the first max_occ occurrences
+ *                    (in SA order) are written.
+ * \param num_threads Number of threads.
+ * \return The number of occurrences of the pattern, which may exceed max_occ.
+ *
+ * \sa locate_interval
+ */
+template<class t_csa, class t_pat_iter>
+typename t_csa::size_type locate(
+    const t_csa&  csa,
+    t_pat_iter begin,
+    t_pat_iter end,
+    uint64_t* occ,
+    typename t_csa::size_type max_occ,
+    uint64_t num_threads=1,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typename t_csa::size_type occ_begin, occ_end, occs;
+    occs = backward_search(csa, 0, csa.size()-1, begin, end, occ_begin, occ_end);
+    if (occs > 0 and max_occ > 0) {
+        locate_interval(csa, occ_begin, occ_begin+std::min(occs, max_occ)-1, occ, num_threads);
+    }
+    return occs;
+}
+
 
 //! Writes the substring T[begin..end] of the original text T to text[0..end-begin+1].
 /*!
@@ -597,6 +880,224 @@ typename t_csa::size_type extract(
     return end-begin+1;
 }
 
+//! Number of text segments which extract decodes in lock-step per thread.
+const uint64_t extract_lockstep_walks = 32;
+
+// Decodes the text segments [seg->first..seg->second) to text[seg->first-begin..]
+// with up to extract_lockstep_walks concurrent cursors. init(segment) returns
+// the cursor of a segment and step(cursor) decodes one symbol; a cursor is
+// finished when pos reaches stop.
+template<class t_csa, class t_seg_iter, class t_init, class t_step>
+void _extract_lockstep(const t_csa&, t_seg_iter seg, t_seg_iter seg_end,
+                       t_init init, t_step step)
+{
+    typedef decltype(init(*seg)) cursor_type;
+    cursor_type c[extract_lockstep_walks];
+    uint64_t cnt = 0;
+    for (; seg != seg_end and cnt < extract_lockstep_walks; ++seg) {
+        c[cnt++] = init(*seg);
+    }
+    while (cnt > 0) {
+        for (uint64_t k=0; k < cnt;) {
+            if (c[k].pos == c[k].stop) {
+                if (seg != seg_end) {
+                    c[k] = init(*seg);
+                    ++seg;
+                } else {
+                    c[k] = c[--cnt];
+                }
+            } else {
+                step(c[k]);
+                ++k;
+            }
+        }
+    }
+}
+
+template<class t_csa, class t_seg_iter, class t_text_iter>
+void _extract_lockstep(const t_csa& csa, typename t_csa::size_type begin,
+                       t_seg_iter seg, t_seg_iter seg_end, t_text_iter text, lf_tag)
+{
+    typedef typename t_csa::size_type size_type;
+    struct cursor {
+        size_type order; // ISA[pos]
+        size_type pos;   // text position which was decoded last
+        size_type stop;  // first position of the segment
+    };
+    // decode each segment backwards, starting at the ISA value of its last position
+    _extract_lockstep(csa, seg, seg_end,
+    [&](const std::pair<size_type, size_type>& s) {
+        size_type order = csa.isa[s.second-1];
+        text[s.second-1-begin] = first_row_symbol(order, csa);
+        return cursor{order, s.second-1, s.first};
+    },
+    [&](cursor& c) {
+        auto rc = csa.wavelet_tree.inverse_select(c.order);
+        c.order = csa.C[csa.char2comp[rc.second]] + rc.first;
+        text[--c.pos-begin] = rc.second;
+    });
+}
+
+template<class t_csa, class t_seg_iter, class t_text_iter>
+void _extract_lockstep(const t_csa& csa, typename t_csa::size_type begin,
+                       t_seg_iter seg, t_seg_iter seg_end, t_text_iter text, psi_tag)
+{
+    typedef typename t_csa::size_type size_type;
+    struct cursor {
+        size_type order; // ISA[pos]
+        size_type pos;   // next text position to decode
+        size_type stop;  // end of the segment (exclusive)
+    };
+    _extract_lockstep(csa, seg, seg_end,
+    [&](const std::pair<size_type, size_type>& s) {
+        return cursor{csa.isa[s.first], s.first, s.second};
+    },
+    [&](cursor& c) {
+        text[c.pos-begin] = first_row_symbol(c.order, csa);
+        if (++c.pos != c.stop) {
+            c.order = csa.psi[c.order];
+        }
+    });
+}
+
+// Splits [a..b) at the multiples of seg_len and appends the parts to segs.
+template<class t_size_type>
+void _extract_segments(t_size_type a, t_size_type b, t_size_type seg_len,
+                       std::vector<std::pair<t_size_type, t_size_type>>& segs)
+{
+    while (a < b) {
+        t_size_type e = std::min(b, (a/seg_len+1)*seg_len);
+        segs.emplace_back(a, e);
+        a = e;
+    }
+}
+
+// Decodes the ranges of T to text with the segment engine.
+template<class t_csa, class t_text_iter>
+void _extract_ranges(const t_csa& csa, typename t_csa::size_type begin,
+                     const std::vector<std::pair<typename t_csa::size_type, typename t_csa::size_type>>& ranges,
+                     t_text_iter text, uint64_t num_threads)
+{
+    typedef typename t_csa::size_type size_type;
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    size_type len = 0;
+    for (auto r : ranges) {
+        len += r.second-r.first;
+    }
+    // Segment borders are multiples of the ISA sample density, so the
+    // first ISA value of each segment is (nearly) a sample. Segments are
+    // made long enough to occupy all cursors of all threads.
+    size_type dens = t_csa::isa_sample_dens;
+    size_type target = num_threads*extract_lockstep_walks;
+    size_type seg_len = std::max(dens, ((len+target-1)/target + dens-1)/dens*dens);
+    std::vector<std::pair<size_type, size_type>> segs;
+    for (auto r : ranges) {
+        _extract_segments(r.first, r.second, seg_len, segs);
+    }
+    num_threads = parallel::threads_for(num_threads, segs.size(), extract_lockstep_walks);
+    parallel::for_each_range(num_threads, segs.size(), [&](uint64_t, uint64_t b, uint64_t e) {
+        typename t_csa::extract_category tag;
+        _extract_lockstep(csa, begin, segs.begin()+b, segs.begin()+e, text, tag);
+    });
+}
+
+//! Writes the substring T[begin..end] to text[0..end-begin+1] by decoding segments concurrently.
+/*!
+ * \tparam t_csa       CSA type.
+ * \tparam t_text_iter Random access iterator type.
+ *
+ * \param csa         The CSA object.
+ * \param begin       Position of the first character which should be extracted (inclusive).
+ * \param end         Position of the last character which should be extracted (inclusive).
+ * \param text        Random access iterator pointing to the start of an container,
+ *                    which can hold at least (end-begin+1) character.
+ * \param num_threads Number of threads. If it is larger than one, text
+ *                    has to support concurrent writes to different elements
+ *                    (e.g. a pointer or a std::string iterator).
+ * \returns The length of the extracted text.
+ *
+ * The range is split into segments which start and end at ISA samples.
+ * The segments are independent, so each thread decodes several of them
+ * in lock-step and the cache misses of the segments overlap.
+ *
+ * \pre \f$begin <= end\f$ and \f$ end < csa.size() \f$
+ * \par Time complexity
+ *        \f$ \Order{ (end-begin+1) \cdot t_{\Psi} / num\_threads + s \cdot t_{SA^{-1}} } \f$,
+ *        where s is the number of segments.
+ */
+template<class t_csa, class t_text_iter>
+typename t_csa::size_type extract(
+    const t_csa& csa,
+    typename t_csa::size_type begin,
+    typename t_csa::size_type end,
+    t_text_iter text,
+    uint64_t num_threads,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    assert(end < csa.size());
+    assert(begin <= end);
+    _extract_ranges(csa, begin, {{begin, end+1}}, text, num_threads);
+    return end-begin+1;
+}
+
+//! Writes the substring T[begin..end] to text[0..end-begin+1], copying the parts stored in a text sample.
+/*!
+ * \param csa         The CSA object.
+ * \param begin       Position of the first character which should be extracted (inclusive).
+ * \param end         Position of the last character which should be extracted (inclusive).
+ * \param text        Random access iterator pointing to the start of an container,
+ *                    which can hold at least (end-begin+1) character.
+ * \param ts          Plain text sample of the CSA.
+ * \param num_threads Number of threads used for the parts which are not in ts.
+ * \returns The length of the extracted text.
+ *
+ * \sa text_sample
+ */
+template<class t_csa, class t_text_iter>
+typename t_csa::size_type extract(
+    const t_csa& csa,
+    typename t_csa::size_type begin,
+    typename t_csa::size_type end,
+    t_text_iter text,
+    const text_sample& ts,
+    uint64_t num_threads=1,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::char_type char_type;
+    assert(end < csa.size());
+    assert(begin <= end);
+    size_type bs = ts.block_size();
+    if (bs == 0) {
+        return extract(csa, begin, end, text, num_threads);
+    }
+    // copy the stored blocks and collect the gaps between them
+    std::vector<std::pair<size_type, size_type>> gaps;
+    for (size_type i=begin; i <= end;) {
+        size_type e = std::min(end+1, (i/bs+1)*bs);
+        if (ts.is_sampled(i)) {
+            for (; i < e; ++i) {
+                text[i-begin] = (char_type)ts[i];
+            }
+        } else {
+            if (!gaps.empty() and gaps.back().second == i) {
+                gaps.back().second = e;
+            } else {
+                gaps.emplace_back(i, e);
+            }
+            i = e;
+        }
+    }
+    if (!gaps.empty()) {
+        _extract_ranges(csa, begin, gaps, text, num_threads);
+    }
+    return end-begin+1;
+}
+
 //! Reconstructs the substring T[begin..end] of the original text T to text[0..end-begin+1].
 /*!
  * \tparam t_rac Random access container which should hold the result.
@@ -275,6 +275,23 @@ class bwt_of_csa_psi
             return m_csa.rank_bwt(i,c);
         }
 
+        //! Calculates rank(i, c) and rank(j, c).
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1], \f$i \leq j \leq size()\f$.
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *    \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Time complexity
+         *        \f$ \Order{\log n t_{\Psi}} \f$
+         */
+        std::pair<size_type, size_type> rank_pair(size_type i, size_type j, const char_type c)const
+        {
+            return {m_csa.rank_bwt(i,c), m_csa.rank_bwt(j,c)};
+        }
+
+        //! Does nothing, since rank is answered by binary searches on \f$\Psi\f$.
+        void prefetch_rank(size_type)const {}
+
         //! Calculates the position of the i-th c.
         /*!
          *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -446,6 +463,29 @@ class bwt_of_csa_wt
             return m_csa.rank_bwt(i, c);
         }
 
+        //! Calculates rank(i, c) and rank(j, c) in one pass over the wavelet tree.
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1], \f$i \leq j \leq size()\f$.
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *    \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Time complexity
+         *        \f$ \Order{\log |\Sigma|} \f$
+         */
+        std::pair<size_type, size_type> rank_pair(size_type i, size_type j, const char_type c)const
+        {
+            return m_csa.rank_bwt_pair(i, j, c);
+        }
+
+        //! Prefetches the memory accessed by the first level of rank(i, c).
+        /*! Issued some steps before rank(i, c), the cache misses of several
+         *  independent ranks overlap.
+         */
+        void prefetch_rank(size_type i)const
+        {
+            m_csa.prefetch_rank_bwt(i);
+        }
+
         //! Calculates the position of the i-th c.
         /*!
          *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
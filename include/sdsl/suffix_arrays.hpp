@@ -31,6 +31,7 @@
 #include "wavelet_trees.hpp"
 #include "construct.hpp"
 #include "suffix_array_algorithm.hpp"
+#include "construct_merge.hpp"
 
 namespace sdsl
 {
@@ -40,17 +41,19 @@ template<class t_wt               = wt_int<>,
          uint32_t t_dens          = 32,
          uint32_t t_inv_dens      = 64,
          class t_sa_sample_strat  = sa_order_sa_sampling<>,
-         class t_isa_sample_strat = isa_sampling<>
+         class t_isa_sample_strat = isa_sampling<>,
+         class t_kmer_table       = kmer_table<>
          >
-using csa_wt_int = csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa_sample_strat, int_alphabet<>>;
+using csa_wt_int = csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa_sample_strat, int_alphabet<>, t_kmer_table>;
 
 template<class t_enc_vec          = enc_vector<>,          // Vector type used to store the Psi-function
          uint32_t t_dens          = 32,                    // Sample density for suffix array (SA) values
          uint32_t t_inv_dens      = 64,                    // Sample density for inverse suffix array (ISA) values
          class t_sa_sample_strat  = sa_order_sa_sampling<>,// Policy class for the SA sampling. Alternative text_order_sa_sampling.
-         class t_isa_sample_strat = isa_sampling<>         // Policy class for the ISA sampling.
+         class t_isa_sample_strat = isa_sampling<>,        // Policy class for the ISA sampling.
+         class t_kmer_table       = kmer_table<>           // Table of SA intervals of all strings of length k.
          >
-using csa_sada_int = csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa_sample_strat, int_alphabet<>>;
+using csa_sada_int = csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa_sample_strat, int_alphabet<>, t_kmer_table>;
 
 }
 
@@ -57,7 +57,7 @@ class cst_node_child_proxy
         using node_type = typename t_cst::node_type;
         using size_type = typename t_cst::size_type;
     private: // data
-        const node_type& m_parent;
+        const node_type m_parent; // a copy, since children() is often called with a temporary
         const t_cst* m_cst;
     public: // constructors
         cst_node_child_proxy() = delete;
@@ -0,0 +1,193 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file text_sample.hpp
+   \brief text_sample.hpp contains the sdsl::text_sample class, which stores
+          selected blocks of the original text in plain form.
+   \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_TEXT_SAMPLE
+#define INCLUDED_SDSL_TEXT_SAMPLE
+
+#include "int_vector.hpp"
+#include "rank_support_v5.hpp"
+#include "util.hpp"
+#include "io.hpp"
+#include <vector>
+#include <utility>
+
+namespace sdsl
+{
+
+//! A sparse plain sample of the text of a CSA.
+/*!
+ *  The text is divided into blocks of a fixed length. The blocks which
+ *  intersect one of the ranges passed to the constructor (e.g. the hot
+ *  regions of a search frontend) are decoded once and stored in plain
+ *  form, so extract can copy them instead of decoding them again.
+ *
+ *  \sa sdsl::extract
+ */
+class text_sample
+{
+    public:
+        typedef int_vector<>::size_type  size_type;
+        typedef int_vector<>::value_type value_type;
+
+    private:
+        size_type         m_block = 0;  // length of a block, 0 if the sample is empty
+        bit_vector        m_marked;     // m_marked[j]=1 iff block j is stored
+        rank_support_v5<> m_marked_rank;
+        int_vector<>      m_text;       // stored blocks, each padded to m_block symbols
+
+        void copy(const text_sample& ts)
+        {
+            m_block = ts.m_block;
+            m_marked = ts.m_marked;
+            m_marked_rank = ts.m_marked_rank;
+            m_marked_rank.set_vector(&m_marked);
+            m_text = ts.m_text;
+        }
+
+    public:
+        text_sample() = default;
+
+        text_sample(const text_sample& ts)
+        {
+            copy(ts);
+        }
+
+        text_sample(text_sample&& ts)
+        {
+            *this = std::move(ts);
+        }
+
+        //! Constructor
+        /*! \param csa         The CSA whose text is sampled.
+         *  \param ranges      Inclusive text ranges [first..second] which should be stored.
+         *  \param block_size  Length of a block.
+         *  \param num_threads Number of threads used to decode the blocks.
+         */
+        template<class t_csa>
+        text_sample(const t_csa& csa,
+                    const std::vector<std::pair<size_type, size_type>>& ranges,
+                    size_type block_size=4096, uint64_t num_threads=1)
+        {
+            size_type n = csa.size();
+            if (n == 0 or block_size == 0) {
+                return;
+            }
+            m_block = block_size;
+            m_marked = bit_vector((n+m_block-1)/m_block, 0);
+            for (auto r : ranges) {
+                if (r.first > r.second or r.first >= n) {
+                    continue;
+                }
+                size_type last = std::min(r.second, n-1)/m_block;
+                for (size_type j=r.first/m_block; j <= last; ++j) {
+                    m_marked[j] = 1;
+                }
+            }
+            util::init_support(m_marked_rank, &m_marked);
+            size_type blocks = m_marked_rank(m_marked.size());
+            m_text = int_vector<>(blocks*m_block, 0, bits::hi(csa.comp2char[csa.sigma-1]|1)+1);
+            std::vector<typename t_csa::char_type> buf(m_block);
+            for (size_type j=0, k=0; j < m_marked.size(); ++j) {
+                if (m_marked[j]) {
+                    size_type len = extract(csa, j*m_block, std::min(n, (j+1)*m_block)-1,
+                                            buf.begin(), num_threads);
+                    for (size_type i=0; i < len; ++i) {
+                        m_text[k*m_block+i] = buf[i];
+                    }
+                    ++k;
+                }
+            }
+        }
+
+        //! Length of a block; 0 if the sample is empty.
+        size_type block_size()const
+        {
+            return m_block;
+        }
+
+        //! Returns whether T[i] is stored.
+        bool is_sampled(size_type i)const
+        {
+            return m_block > 0 and i/m_block < m_marked.size() and m_marked[i/m_block];
+        }
+
+        //! Returns T[i].
+        /*! \pre is_sampled(i)
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(is_sampled(i));
+            return m_text[m_marked_rank(i/m_block)*m_block + i%m_block];
+        }
+
+        text_sample& operator=(const text_sample& ts)
+        {
+            if (this != &ts) {
+                copy(ts);
+            }
+            return *this;
+        }
+
+        text_sample& operator=(text_sample&& ts)
+        {
+            if (this != &ts) {
+                m_block = ts.m_block;
+                m_marked = std::move(ts.m_marked);
+                m_marked_rank = std::move(ts.m_marked_rank);
+                m_marked_rank.set_vector(&m_marked);
+                m_text = std::move(ts.m_text);
+            }
+            return *this;
+        }
+
+        void swap(text_sample& ts)
+        {
+            if (this != &ts) {
+                std::swap(m_block, ts.m_block);
+                m_marked.swap(ts.m_marked);
+                util::swap_support(m_marked_rank, ts.m_marked_rank, &m_marked, &(ts.m_marked));
+                m_text.swap(ts.m_text);
+            }
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_block, out, child, "block_size");
+            written_bytes += m_marked.serialize(out, child, "marked");
+            written_bytes += m_marked_rank.serialize(out, child, "marked_rank");
+            written_bytes += m_text.serialize(out, child, "text");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in)
+        {
+            read_member(m_block, in);
+            m_marked.load(in);
+            m_marked_rank.load(in, &m_marked);
+            m_text.load(in);
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -228,7 +228,7 @@ uint64_t pid();
 class _id_helper
 {
     private:
-        static uint64_t id;
+        static std::atomic<uint64_t> id;
     public:
         static uint64_t getId() {
             return id++;
@@ -310,6 +310,41 @@ void init_support(S& s, const X* x)
     s.set_vector(x); // set the support object's  pointer to x
 }
 
+//! Hints the processor to load the word of v which contains element idx into the cache.
+template<class t_int_vec>
+inline void prefetch(const t_int_vec& v, uint64_t idx)
+{
+    __builtin_prefetch(v.data() + ((idx*v.width())>>6));
+}
+
+//! Number of queries which are prefetched ahead in batch_queries.
+const uint64_t batch_prefetch_distance = 16;
+
+//! Answers a batch of independent queries with overlapping cache misses.
+/*! \param in       Arguments of the queries.
+ *  \param n        Number of queries.
+ *  \param out      Receives out[j] = query(in[j]) for \f$j\in[0..n-1]\f$.
+ *  \param prefetch Function which prefetches the memory accessed by query(x).
+ *  \param query    The query function.
+ *
+ *  prefetch(in[j+batch_prefetch_distance]) is issued before query(in[j]),
+ *  so the memory latency of several queries overlaps.
+ */
+template<class t_prefetch, class t_query>
+void batch_queries(const uint64_t* in, size_t n, uint64_t* out, t_prefetch prefetch, t_query query)
+{
+    size_t d = std::min(n, (size_t)batch_prefetch_distance);
+    for (size_t j=0; j < d; ++j) {
+        prefetch(in[j]);
+    }
+    for (size_t j=0; j < n; ++j) {
+        if (j+d < n) {
+            prefetch(in[j+d]);
+        }
+        out[j] = query(in[j]);
+    }
+}
+
 class spin_lock
 {
     private:
@@ -394,15 +429,16 @@ void util::bit_compress(t_int_vec& v)
     uint8_t min_width = bits::hi(max)+1;
     uint8_t old_width = v.width();
     if (old_width > min_width) {
-        const uint64_t* read_data = v.data();
-        uint64_t* write_data = v.data();
-        uint8_t read_offset = 0;
-        uint8_t write_offset = 0;
-        for (typename t_int_vec::size_type i=0; i < v.size(); ++i) {
-            uint64_t x = bits::read_int_and_move(read_data, read_offset, old_width);
-            bits::write_int_and_move(write_data,  x, write_offset, min_width);
+        // blocks are decoded before they are overwritten, since the
+        // compressed block ends before the next uncompressed block starts
+        const typename t_int_vec::size_type n = v.size();
+        uint64_t buf[1024];
+        for (typename t_int_vec::size_type i=0; i < n; i += 1024) {
+            uint64_t len = std::min((typename t_int_vec::size_type)1024, n-i);
+            bits::read_ints(v.data(), i*old_width, old_width, len, buf);
+            bits::write_ints(v.data(), i*min_width, min_width, len, buf);
         }
-        v.bit_resize(v.size()*min_width);
+        v.bit_resize(n*min_width);
         v.width(min_width);
     }
 }
@@ -413,12 +449,15 @@ void util::expand_width(t_int_vec& v, uint8_t new_width)
     uint8_t old_width = v.width();
     typename t_int_vec::size_type n = v.size();
     if (new_width > old_width and n > 0) {
-        typename t_int_vec::size_type i, old_pos, new_pos;
-        new_pos = (n-1)*new_width;
-        old_pos = (n-1)*old_width;
         v.bit_resize(v.size()*new_width);
-        for (i=0; i < n; ++i, new_pos-=new_width, old_pos-=old_width) {
-            v.set_int(new_pos, v.get_int(old_pos, old_width), new_width);
+        // blocks are expanded from the end, so the expanded block starts
+        // after the end of the blocks which are not read yet
+        uint64_t buf[1024];
+        for (typename t_int_vec::size_type i=n; i > 0;) {
+            uint64_t len = std::min((typename t_int_vec::size_type)1024, i);
+            i -= len;
+            bits::read_ints(v.data(), i*old_width, old_width, len, buf);
+            bits::write_ints(v.data(), i*new_width, new_width, len, buf);
         }
         v.width(new_width);
     }
@@ -504,12 +543,10 @@ typename t_int_vec::size_type util::cnt_one_bits(const t_int_vec& v)
     const uint64_t* data = v.data();
     if (v.empty())
         return 0;
-    typename t_int_vec::size_type result = bits::cnt(*data);
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        result += bits::cnt(*(++data));
-    }
+    typename t_int_vec::size_type words = v.capacity()>>6;
+    typename t_int_vec::size_type result = bits::cnt(data, words);
     if (v.bit_size()&0x3F) {
-        result -= bits::cnt((*data) & (~bits::lo_set[v.bit_size()&0x3F]));
+        result -= bits::cnt(data[words-1] & (~bits::lo_set[v.bit_size()&0x3F]));
     }
     return result;
 }
@@ -95,8 +95,6 @@ class wm_int
         uint32_t               m_max_level = 0;
         int_vector<64>         m_zero_cnt;     // m_zero_cnt[i] contains the number of zeros in level i
         int_vector<64>         m_rank_level;   // m_rank_level[i] contains m_tree_rank(i*size())
-        mutable int_vector<64> m_path_off;     // array keeps track of path offset in select-like methods
-        mutable int_vector<64> m_path_rank_off;// array keeps track of rank values for the offsets
 
         void copy(const wm_int& wt) {
             m_size          = wt.m_size;
@@ -111,15 +109,133 @@ class wm_int
             m_max_level     = wt.m_max_level;
             m_zero_cnt      = wt.m_zero_cnt;
             m_rank_level    = wt.m_rank_level;
-            m_path_off      = wt.m_path_off;
-            m_path_rank_off = wt.m_path_rank_off;
         }
 
     private:
 
-        void init_buffers(uint32_t max_level) {
-            m_path_off = int_vector<64>(max_level+1);
-            m_path_rank_off = int_vector<64>(max_level+1);
+        //! Number of levels which are built in one pass over the sequence
+        static const uint32_t levels_per_pass = 4;
+
+        // Constructs the levels by stable counting sorts on up to levels_per_pass
+        // bits. The key of an element is the reversed bit chunk of the levels of the
+        // pass, so that its lowest i bits determine the position on the i-th level
+        // of the pass. The bits of the levels are appended to tree_out_buf. If
+        // semi_external is set, all buckets except the first are written to
+        // temporary files, while the first is compacted in place.
+        template<class t_rac>
+        void construct_levels(t_rac& rac, osfstream& tree_out_buf,
+                              const std::string& tmp_prefix, bool semi_external) {
+            const size_type n = rac.size();
+            size_type tree_pos = 0;
+            uint64_t tree_word = 0;
+            auto append_bits = [&](const bit_vector& bv, size_type begin, size_type len) {
+                for (size_type i=0; i < len; i+=64) {
+                    uint8_t l = std::min((size_type)64, len-i);
+                    uint64_t w = bv.get_int(begin+i, l);
+                    uint8_t offset = tree_pos&0x3FULL;
+                    tree_word |= w << offset;
+                    tree_pos += l;
+                    if (offset + l >= 64) { // the word is full
+                        tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                        tree_word = offset ? (w >> (64-offset)) : 0;
+                    }
+                }
+            };
+            t_rac rac_next;
+            if (!semi_external) {
+                rac_next = t_rac(n, 0, rac.width());
+            }
+            for (uint32_t k=0; k < m_max_level; k+=levels_per_pass) {
+                const uint32_t b = std::min((uint32_t)levels_per_pass, m_max_level-k);
+                const uint32_t shift = m_max_level-k-b;
+                const uint64_t buckets = 1ULL<<b;
+                // bit j of rev[c] is the bit of level k+j
+                std::vector<uint64_t> rev(buckets, 0);
+                for (uint64_t c=0; c < buckets; ++c) {
+                    for (uint32_t j=0; j < b; ++j) {
+                        rev[c] |= ((c >> (b-1-j))&1ULL) << j;
+                    }
+                }
+                auto key = [&](uint64_t x) {
+                    return rev[(x >> shift) & (buckets-1)];
+                };
+                // (1) Count the keys
+                std::vector<size_type> hist(buckets, 0);
+                for (size_type i=0; i < n; ++i) {
+                    ++hist[key(rac[i])];
+                }
+                // (2) Start positions of the keys restricted to their lowest i bits
+                //     on level k+i and the number of zeros on each level
+                std::vector<std::vector<size_type>> pos(b+1);
+                for (uint32_t i=1; i <= b; ++i) {
+                    pos[i].assign(1ULL<<i, 0);
+                    for (uint64_t r=0; r < buckets; ++r) {
+                        pos[i][r & ((1ULL<<i)-1)] += hist[r];
+                    }
+                    size_type sum = 0;
+                    for (auto& p : pos[i]) {
+                        size_type cnt = p;
+                        p = sum;
+                        sum += cnt;
+                    }
+                }
+                for (uint32_t j=0; j < b; ++j) {
+                    m_zero_cnt[k+j] = 0;
+                    for (uint64_t r=0; r < buckets; ++r) {
+                        if (!((r>>j)&1ULL)) {
+                            m_zero_cnt[k+j] += hist[r];
+                        }
+                    }
+                }
+                // (3) Write the bits of the b levels and distribute the elements
+                bit_vector level_bits(b*n, 0);
+                std::vector<int_vector_buffer<>> bucket_buf;
+                if (semi_external) {
+                    bucket_buf.reserve(buckets-1);
+                    for (uint64_t r=1; r < buckets; ++r) {
+                        bucket_buf.emplace_back(tmp_file(tmp_prefix, "_wm_bucket_"+util::to_string(r)),
+                                                std::ios::out, 1024*1024, rac.width());
+                    }
+                }
+                for (size_type i=0; i < n; ++i) {
+                    uint64_t x = rac[i];
+                    uint64_t r = key(x);
+                    if (r&1ULL) {
+                        level_bits[i] = 1;
+                    }
+                    for (uint32_t j=1; j < b; ++j) {
+                        size_type p = pos[j][r & ((1ULL<<j)-1)]++;
+                        if ((r>>j)&1ULL) {
+                            level_bits[j*n+p] = 1;
+                        }
+                    }
+                    if (!semi_external) {
+                        rac_next[pos[b][r]++] = x;
+                    } else if (r == 0) {
+                        rac[pos[b][0]++] = x; // the first bucket is never ahead of i
+                    } else {
+                        bucket_buf[r-1].push_back(x);
+                    }
+                }
+                if (!semi_external) {
+                    rac.swap(rac_next);
+                } else {
+                    for (uint64_t r=1; r < buckets; ++r) {
+                        int_vector_buffer<>& bb = bucket_buf[r-1];
+                        size_type p = pos[b][r];
+                        for (size_type i=0; i < bb.size(); ++i) {
+                            rac[p+i] = bb[i];
+                        }
+                        bb.close(true);
+                    }
+                }
+                for (uint32_t j=0; j < b; ++j) {
+                    append_bits(level_bits, j*n, n);
+                }
+            }
+            if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
+                tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+            }
         }
 
     public:
@@ -129,9 +245,7 @@ class wm_int
         const uint32_t&        max_level = m_max_level; //!< Maximal level of the wavelet tree.
 
         //! Default constructor
-        wm_int() {
-            init_buffers(m_max_level);
-        };
+        wm_int() {};
 
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wm_int should be build.
@@ -142,11 +256,17 @@ class wm_int
          *        I.e. we need \Order{n\log n} if rac is a permutation of 0..n-1.
          *    \par Space complexity
          *        \f$ n\log|\Sigma| + O(1)\f$ bits, where \f$n=size\f$.
+         *        The levels are built in passes of four levels by stable counting sorts
+         *        in memory, which takes \f$ 2n\log|\Sigma| + 4n\f$ bits. If
+         *        construct_config::wm_semi_external is set, the buckets are
+         *        streamed through temporary files instead, which reduces the space
+         *        to \f$ n\log|\Sigma| + 4n\f$ bits plus the file buffers.
+         *        If construct_config::num_threads > 1 and n is large, the levels are
+         *        partitioned in parallel in memory, which takes \f$ 2n\log|\Sigma|\f$ bits.
          */
         template<uint8_t int_width>
         wm_int(int_vector_buffer<int_width>& buf, size_type size,
                uint32_t max_level=0) : m_size(size) {
-            init_buffers(m_max_level);
             if (0 == m_size)
                 return;
             size_type n = buf.size();  // set n
@@ -170,60 +290,33 @@ class wm_int
             } else {
                 m_max_level = max_level;
             }
-            init_buffers(m_max_level);
-
-
-            std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
-            osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary | std::ios::trunc | std::ios::out);   // open buffer for tree
-            size_type bit_size = m_size*m_max_level;
-            tree_out_buf.write((char*) &bit_size, sizeof(bit_size));    // write size of bit_vector
-
-            std::string zero_buf_file_name = tmp_file(buf.filename(), "_zero_buf");
 
-            size_type tree_pos = 0;
-            uint64_t tree_word = 0;
 
             m_zero_cnt = int_vector<64>(m_max_level, 0); // zeros at level i
 
-            for (uint32_t k=0; k<m_max_level; ++k) {
-                uint8_t        width = m_max_level-k-1;
-                const uint64_t mask  = 1ULL<<width;
-                uint64_t       x     = 0;
-                size_type      zeros = 0;
-                int_vector_buffer<> zero_buf(zero_buf_file_name, std::ios::out, 1024*1024, m_max_level);
-                for (size_t i=0; i<m_size; ++i) {
-                    x = rac[i];
-                    if (x&mask) {
-                        tree_word |= (1ULL << (tree_pos&0x3FULL));
-                        zero_buf.push_back(x);
-                    } else {
-                        rac[zeros++ ] = x;
-                    }
-                    ++tree_pos;
-                    if ((tree_pos & 0x3FULL) == 0) { // if tree_pos % 64 == 0 write old word
-                        tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
-                        tree_word = 0;
-                    }
-                }
-                m_zero_cnt[k] = zeros;
-                for (size_t i=zeros; i<m_size; ++i) {
-                    rac[i] = zero_buf[i-zeros];
-                }
-            }
-            if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
-                tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+            bit_vector tree;
+            uint64_t threads = wt_construct_threads(m_size);
+            if (threads > 1) {
+                tree = bit_vector(m_size*m_max_level, 0);
+                construct_int_levels(rac, tree, m_max_level, false, m_zero_cnt, threads);
+            } else {
+                std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
+                osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary | std::ios::trunc | std::ios::out);   // open buffer for tree
+                size_type bit_size = m_size*m_max_level;
+                tree_out_buf.write((char*) &bit_size, sizeof(bit_size));    // write size of bit_vector
+                construct_levels(rac, tree_out_buf, buf.filename(), construct_config::wm_semi_external);
+                tree_out_buf.close();
+                load_from_file(tree, tree_out_buf_file_name);
+                sdsl::remove(tree_out_buf_file_name);
             }
-            sdsl::remove(zero_buf_file_name);
-            tree_out_buf.close();
             m_sigma = std::unique(rac.begin(), rac.end()) - rac.begin();
             rac.resize(0);
-            bit_vector tree;
-            load_from_file(tree, tree_out_buf_file_name);
-            sdsl::remove(tree_out_buf_file_name);
             m_tree = bit_vector_type(std::move(tree));
-            util::init_support(m_tree_rank, &m_tree);
-            util::init_support(m_tree_select0, &m_tree);
-            util::init_support(m_tree_select1, &m_tree);
+            parallel::invoke(threads, {
+                [&]() { util::init_support(m_tree_rank, &m_tree); },
+                [&]() { util::init_support(m_tree_select0, &m_tree); },
+                [&]() { util::init_support(m_tree_select1, &m_tree); }
+            });
             m_rank_level = int_vector<64>(m_max_level, 0);
             for (uint32_t k=0; k<m_rank_level.size(); ++k) {
                 m_rank_level[k] = m_tree_rank(k*m_size);
@@ -263,8 +356,6 @@ class wm_int
                 m_max_level     = std::move(wt.m_max_level);
                 m_zero_cnt      = std::move(wt.m_zero_cnt);
                 m_rank_level    = std::move(wt.m_rank_level);
-                m_path_off      = std::move(wt.m_path_off);
-                m_path_rank_off = std::move(wt.m_path_rank_off);
             }
             return *this;
         }
@@ -281,8 +372,6 @@ class wm_int
                 std::swap(m_max_level,  wt.m_max_level);
                 m_zero_cnt.swap(wt.m_zero_cnt);
                 m_rank_level.swap(wt.m_rank_level);
-                m_path_off.swap(wt.m_path_off);
-                m_path_rank_off.swap(wt.m_path_rank_off);
             }
         }
 
@@ -352,6 +441,50 @@ class wm_int
             return i;
         };
 
+        //! Calculates rank(i, c) and rank(j, c) in one traversal of the levels.
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1].
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *  \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Time complexity
+         *        \f$ \Order{\log |\Sigma|} \f$
+         *  \par Precondition
+         *       \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (((1ULL)<<(m_max_level))<=c) { // c is greater than any symbol in wt
+                return {0, 0};
+            }
+            size_type b = 0; // start position of the interval
+            uint64_t mask = (1ULL) << (m_max_level-1);
+            for (uint32_t k=0; k < m_max_level and j; ++k) {
+                size_type rank_b = m_tree_rank(b);
+                size_type ones_i = m_tree_rank(b + i) - rank_b; // ones in [b..i)
+                // once the interval is empty only one rank per level is needed
+                size_type ones_j = (i == j) ? ones_i : m_tree_rank(b + j) - rank_b;
+                size_type ones_p = rank_b - m_rank_level[k];    // ones in [level_b..b)
+                if (c & mask) { // search for a one at this level
+                    i = ones_i;
+                    j = ones_j;
+                    b = (k+1)*m_size + m_zero_cnt[k] + ones_p;
+                } else { // search for a zero at this level
+                    i = i-ones_i;
+                    j = j-ones_j;
+                    b = (k+1)*m_size + (b - k*m_size - ones_p);
+                }
+                mask >>= 1;
+            }
+            return {i, j};
+        };
+
+        //! Prefetches the memory accessed by the rank on the first level of rank(i, c).
+        void prefetch_rank(size_type i)const {
+            prefetch_support(m_tree_rank, i);
+        }
+
         //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
         /*!
          *  \param i The index of the symbol.
@@ -395,7 +528,9 @@ class wm_int
         size_type select(size_type i, value_type c)const {
             assert(1 <= i and i <= rank(size(), c));
             uint64_t mask = 1ULL << (m_max_level-1);
-            m_path_off[0] = m_path_rank_off[0] = 0;
+            // path offsets and their ranks; local, so that concurrent queries are safe
+            size_type path_off[65], path_rank_off[65];
+            path_off[0] = path_rank_off[0] = 0;
             size_type b = 0; // start position of the interval
             size_type r = i;
             for (uint32_t k=0; k < m_max_level and i; ++k) {
@@ -410,13 +545,13 @@ class wm_int
                     b = (k+1)*m_size + (b - k*m_size - ones_p);
                 }
                 mask >>= 1;
-                m_path_off[k+1] = b;
-                m_path_rank_off[k] = rank_b;
+                path_off[k+1] = b;
+                path_rank_off[k] = rank_b;
             }
             mask = 1ULL;
             for (uint32_t k=m_max_level; k>0; --k) {
-                b = m_path_off[k-1];
-                size_type rank_b = m_path_rank_off[k-1];
+                b = path_off[k-1];
+                size_type rank_b = path_rank_off[k-1];
                 if (c & mask) { // right child => search i'th one
                     i = m_tree_select1(rank_b + i) - b + 1;
                 } else { // left child => search i'th zero
@@ -544,7 +679,6 @@ class wm_int
             read_member(m_max_level, in);
             m_zero_cnt.load(in);
             m_rank_level.load(in);
-            init_buffers(m_max_level);
         }
 
         //! Represents a node in the wavelet tree
@@ -25,11 +25,23 @@
 #include <sdsl/bit_vectors.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/vectors.hpp>
+#include <algorithm>
+#include <tuple>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
 {
 
+//! Number of values smaller than or equal to val in the sorted range [begin, end).
+template<class t_it>
+uint64_t _count_up_to(t_it begin, t_it end, uint64_t val)
+{
+    if (end-begin<50) { // After a short test, this seems to be a good threshold
+        return std::find_if(begin, end, [&val](const decltype(*begin) x) { return x > val; }) - begin;
+    }
+    return std::lower_bound(begin, end, val+1) - begin;
+}
+
 //! Class inv_multi_perm_support adds access to the inverse of permutations.
 /*!
  * \tparam t_s    Sampling parameter of the inverse permutation.
@@ -313,6 +325,17 @@ class wt_gmr_rs
         uint64_t m_blocks; // blocks per character
         uint64_t m_sigma = 0;
 
+        //! Returns the number of occurrences of c before the block of position i-1
+        //! and the range of the sorted offsets of c inside this block.
+        std::tuple<size_type, typename t_rac::const_iterator, typename t_rac::const_iterator>
+        c_block(size_type i, value_type c)const {
+            size_type ones_before_cblock = m_bv_blocks_select0(c*m_blocks+1)-c*m_blocks;
+            size_type block = c*m_blocks+(i-1)/m_block_size+1;
+            auto begin = m_e.begin()+m_bv_blocks_select0(block)-block+1;
+            auto end = m_e.begin()+m_bv_blocks_select0(block+1)-block;
+            return std::make_tuple((begin-m_e.begin())-ones_before_cblock, begin, end);
+        }
+
     public:
 
         const size_type&       sigma = m_sigma;
@@ -487,20 +510,34 @@ class wt_gmr_rs
             if (0==i or c>m_block_size-1) {
                 return 0;
             }
+            auto b = c_block(i, c);
+            return std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (i-1)%m_block_size);
+        }
 
-            size_type offset=0;
-            size_type ones_before_cblock = m_bv_blocks_select0(c*m_blocks+1)-c*m_blocks;
-
-            auto begin = m_e.begin()+m_bv_blocks_select0(c*m_blocks+(i-1)/m_block_size+1)-(c*m_blocks+(i-1)/m_block_size+1)+1;
-            auto end = m_e.begin()+m_bv_blocks_select0(c*m_blocks+(i-1)/m_block_size+2)-(c*m_blocks+(i-1)/m_block_size+1);
-
-            size_type val = (i-1)%m_block_size;
-            if (end-begin<50) { // After a short test, this seems to be a good threshold
-                offset = std::find_if(begin, end, [&val](const decltype(*begin) x) { return x > val; }) - begin;
-            } else {
-                offset = lower_bound(begin, end, val+1)-begin;
+        //! Calculates rank(i, c) and rank(j, c), sharing the block lookups if i and j fall into the same block.
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1].
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *  \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Precondition
+         *       \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (0==i or (i-1)/m_block_size != (j-1)/m_block_size) {
+                return {rank(i, c), rank(j, c)};
+            }
+            if (c>m_block_size-1) {
+                return {0, 0};
             }
-            return (begin-m_e.begin())+offset-ones_before_cblock;
+            auto b = c_block(i, c);
+            size_type rank_i = std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (i-1)%m_block_size);
+            if (i == j) {
+                return {rank_i, rank_i};
+            }
+            return {rank_i, std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (j-1)%m_block_size)};
         }
 
         //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
@@ -642,6 +679,18 @@ class wt_gmr
         uint64_t m_chunksize;
         uint64_t m_sigma = 0;
 
+        //! Returns the number of occurrences of c before the chunk of position i-1
+        //! and the range of the sorted offsets of c inside this chunk.
+        std::tuple<size_type, typename t_rac::const_iterator, typename t_rac::const_iterator>
+        c_chunk(size_type i, value_type c)const {
+            uint64_t chunk = (i-1)/m_chunksize;
+            uint64_t ones_before_c = m_bv_blocks_select0(c*m_chunks+1)-(c*m_chunks+1)+1;
+            uint64_t c_ones_before_chunk = m_bv_blocks_select0(c*m_chunks+chunk+1)-(c*m_chunks+chunk+1)+1-ones_before_c;
+            auto begin = m_perm.begin()+m_bv_chunks_select0(chunk*m_max_symbol+1+c)-(chunk*m_max_symbol+1+c)+1;
+            auto end = m_perm.begin()+m_bv_chunks_select0(chunk*m_max_symbol+2+c)-(chunk*m_max_symbol+2+c)+1;
+            return std::make_tuple(c_ones_before_chunk, begin, end);
+        }
+
     public:
 
         const size_type&       sigma = m_sigma;
@@ -828,22 +877,34 @@ class wt_gmr
             if (0==i or c>m_max_symbol-1)  {
                 return 0;
             }
+            auto b = c_chunk(i, c);
+            return std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (i-1)%m_chunksize);
+        }
 
-            uint64_t chunk = (i-1)/m_chunksize;
-            uint64_t ones_before_c = m_bv_blocks_select0(c*m_chunks+1)-(c*m_chunks+1)+1;
-            uint64_t c_ones_before_chunk = m_bv_blocks_select0(c*m_chunks+chunk+1)-(c*m_chunks+chunk+1)+1-ones_before_c;
-
-            uint64_t c_ones_in_chunk = 0;
-            auto begin = m_perm.begin()+m_bv_chunks_select0(chunk*m_max_symbol+1+c)-(chunk*m_max_symbol+1+c)+1;
-            auto end = m_perm.begin()+m_bv_chunks_select0(chunk*m_max_symbol+2+c)-(chunk*m_max_symbol+2+c)+1;
-
-            size_type val = (i-1)%m_chunksize;
-            if (end-begin<50) { // After a short test, this seems to be a good threshold
-                c_ones_in_chunk = std::find_if(begin, end, [&val](const decltype(*begin) x) { return x > val; }) - begin;
-            } else {
-                c_ones_in_chunk = lower_bound(begin, end, val+1) - begin;
+        //! Calculates rank(i, c) and rank(j, c), sharing the chunk lookups if i and j fall into the same chunk.
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1].
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *  \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Precondition
+         *       \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (0==i or (i-1)/m_chunksize != (j-1)/m_chunksize) {
+                return {rank(i, c), rank(j, c)};
+            }
+            if (c>m_max_symbol-1) {
+                return {0, 0};
+            }
+            auto b = c_chunk(i, c);
+            size_type rank_i = std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (i-1)%m_chunksize);
+            if (i == j) {
+                return {rank_i, rank_i};
             }
-            return c_ones_before_chunk+c_ones_in_chunk;
+            return {rank_i, std::get<0>(b)+_count_up_to(std::get<1>(b), std::get<2>(b), (j-1)%m_chunksize)};
         }
 
         //! Calculates how many occurrences of symbol input[i] are in the prefix [0..i-1] of the original input.
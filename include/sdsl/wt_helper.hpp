@@ -2,6 +2,8 @@
 #define INCLUDED_SDSL_WT_HELPER
 
 #include "int_vector.hpp"
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
 #include <algorithm>
 #include <limits>
 #include <deque>
@@ -55,6 +57,243 @@ void calculate_effective_alphabet_size(const t_rac& C, sigma_type& sigma)
     });
 }
 
+//! Minimal number of symbols per thread in the parallel construction of the wavelet trees.
+const int_vector_size_type wt_parallel_min_chunk = 1ULL<<12;
+
+//! Number of threads used to construct a wavelet tree over n symbols.
+inline uint64_t wt_construct_threads(int_vector_size_type n)
+{
+    return parallel::threads_for(construct_config::num_threads, n, wt_parallel_min_chunk);
+}
+
+//! Constructs the levels of a wavelet tree or matrix over integers with several threads.
+/*!
+ * \param rac        The sequence, which is partitioned level by level.
+ * \param tree       Bit vector of size rac.size()*max_level initialized to 0.
+ * \param max_level  Number of levels.
+ * \param per_node   If true, the elements are partitioned inside each node
+ *                   (wt_int), otherwise over the whole level (wm_int).
+ * \param zero_cnt   zero_cnt[k] is set to the number of zeros on level k.
+ * \param num_threads Number of threads.
+ * \returns The number of non-empty leaves of the wavelet tree.
+ *
+ * Level k contains bit max_level-k-1 of the elements in the order
+ * of the stable partitioning of the previous levels. Each thread
+ * scans a range of the level and collects the sizes of the node parts in
+ * it. A sequential prefix sum over these runs yields the target positions, so
+ * that the threads can partition their ranges independently. The result is the
+ * same as for the sequential construction.
+ */
+template<class t_rac>
+uint64_t construct_int_levels(t_rac& rac, bit_vector& tree, uint32_t max_level,
+                              bool per_node, int_vector<64>& zero_cnt, uint64_t num_threads)
+{
+    typedef int_vector_size_type size_type;
+    struct node_run {
+        uint64_t  key;
+        size_type zeros, ones;
+        size_type zero_pos, one_pos;
+    };
+    const size_type n = rac.size();
+    const uint8_t width = rac.width();
+    num_threads = parallel::threads_for(num_threads, n);
+    std::vector<size_type> bounds(num_threads+1, 0);
+    for (uint64_t t=0; t <= num_threads; ++t) {
+        bounds[t] = (n*t)/num_threads;
+    }
+    std::vector<std::vector<node_run>> runs(num_threads);
+    t_rac rac_next(n, 0, width);
+    uint64_t leaves = 0;
+    uint64_t mask_old = 1ULL<<max_level;
+    for (uint32_t k=0; k < max_level; ++k) {
+        const uint64_t mask_new = 1ULL<<(max_level-k-1);
+        const uint64_t key_mask = per_node ? mask_old : 0;
+        // (1) Write the bits of level k and collect the runs of each node in each range
+        parallel::run(num_threads, [&](uint64_t t) {
+            std::vector<node_run>& r = runs[t];
+            r.clear();
+            for (size_type i=bounds[t]; i < bounds[t+1]; ++i) {
+                uint64_t x = rac[i];
+                if (r.empty() or r.back().key != (x&key_mask)) {
+                    r.push_back({x&key_mask, 0, 0, 0, 0});
+                }
+                if (x&mask_new) {
+                    ++r.back().ones;
+                    parallel::or_bits_in_range(tree.data(), k*n+bounds[t], k*n+bounds[t+1], k*n+i, 1, 1);
+                } else {
+                    ++r.back().zeros;
+                }
+            }
+        });
+        // (2) Calculate the target positions of the runs; a node may span several ranges
+        std::vector<node_run*> all;
+        for (auto& r : runs) {
+            for (auto& run : r) {
+                all.push_back(&run);
+            }
+        }
+        size_type start = 0, level_zeros = 0;
+        for (size_type j=0; j < all.size();) {
+            size_type l = j, zeros = 0, ones = 0;
+            for (; l < all.size() and all[l]->key == all[j]->key; ++l) {
+                zeros += all[l]->zeros;
+                ones  += all[l]->ones;
+            }
+            size_type zero_pos = start, one_pos = start + zeros;
+            for (; j < l; ++j) {
+                all[j]->zero_pos = zero_pos;
+                all[j]->one_pos  = one_pos;
+                zero_pos += all[j]->zeros;
+                one_pos  += all[j]->ones;
+            }
+            if (k+1 == max_level) {
+                leaves += (zeros>0) + (ones>0);
+            }
+            start += zeros + ones;
+            level_zeros += zeros;
+        }
+        zero_cnt[k] = level_zeros;
+        // (3) Partition the ranges; the targets of different runs share at most a word
+        parallel::run(num_threads, [&](uint64_t t) {
+            size_type i = bounds[t];
+            for (auto& run : runs[t]) {
+                const uint64_t zero_begin = run.zero_pos*width, zero_end = (run.zero_pos+run.zeros)*width;
+                const uint64_t one_begin = run.one_pos*width, one_end = (run.one_pos+run.ones)*width;
+                for (size_type l=0; l < run.zeros + run.ones; ++l, ++i) {
+                    uint64_t x = rac[i];
+                    if (x&mask_new) {
+                        parallel::or_bits_in_range(rac_next.data(), one_begin, one_end, (run.one_pos++)*width, x, width);
+                    } else {
+                        parallel::or_bits_in_range(rac_next.data(), zero_begin, zero_end, (run.zero_pos++)*width, x, width);
+                    }
+                }
+            }
+        });
+        rac.swap(rac_next);
+        size_type words = (rac_next.bit_size()+63)>>6;
+        parallel::for_each_range(num_threads, words, [&](uint64_t, size_type b, size_type e) {
+            std::fill(rac_next.data()+b, rac_next.data()+e, 0);
+        });
+        mask_old += mask_new;
+    }
+    return leaves;
+}
+
+// has_rank_pair<X>::value is true if class X implements
+// the fused rank method rank_pair(i, j, c)
+template<typename t_wt>
+struct has_rank_pair {
+    template<typename T>
+    static constexpr auto check(T*)
+    -> typename
+    std::is_same<
+    decltype(std::declval<T>().rank_pair(
+                 std::declval<typename T::size_type>(),
+                 std::declval<typename T::size_type>(),
+                 std::declval<typename T::value_type>()
+             )),
+             std::pair<typename T::size_type, typename T::size_type>>::type {return std::true_type();}
+             template<typename>
+    static constexpr std::false_type check(...) {return std::false_type();}
+    typedef decltype(check<t_wt>(nullptr)) type;
+    static constexpr bool value = type::value;
+};
+
+template<typename t_wt, bool t_has_rank_pair>
+struct _rank_pair_wt {
+    typedef typename t_wt::size_type  size_type;
+    typedef typename t_wt::value_type value_type;
+
+    static std::pair<size_type, size_type>
+    call(const t_wt& wt, size_type i, size_type j, value_type c) {
+        return wt.rank_pair(i, j, c);
+    }
+};
+
+template<typename t_wt>
+struct _rank_pair_wt<t_wt, false> {
+    typedef typename t_wt::size_type  size_type;
+    typedef typename t_wt::value_type value_type;
+
+    static std::pair<size_type, size_type>
+    call(const t_wt& wt, size_type i, size_type j, value_type c) {
+        return {wt.rank(i, c), wt.rank(j, c)};
+    }
+};
+
+//! Returns (wt.rank(i, c), wt.rank(j, c)).
+/*! Uses the fused method rank_pair of the wavelet tree if available.
+ *  \par Precondition
+ *       \f$ i \leq j \leq wt.size() \f$
+ */
+template<class t_wt>
+std::pair<typename t_wt::size_type, typename t_wt::size_type>
+rank_pair(const t_wt& wt, typename t_wt::size_type i,
+          typename t_wt::size_type j, typename t_wt::value_type c)
+{
+    return _rank_pair_wt<t_wt, has_rank_pair<t_wt>::value>::call(wt, i, j, c);
+}
+
+// has_prefetch<X>::value is true if class X implements
+// the method prefetch(i), e.g. a rank support
+template<typename t_x>
+struct has_prefetch {
+    template<typename T>
+    static constexpr auto check(T*)
+    -> typename
+    std::is_same<
+    decltype(std::declval<const T>().prefetch(
+                 std::declval<typename T::size_type>()
+             )),
+             void>::type {return std::true_type();}
+             template<typename>
+    static constexpr std::false_type check(...) {return std::false_type();}
+    typedef decltype(check<t_x>(nullptr)) type;
+    static constexpr bool value = type::value;
+};
+
+//! Calls x.prefetch(i) if class t_x implements it and does nothing otherwise.
+template<class t_x>
+typename std::enable_if<has_prefetch<t_x>::value>::type
+prefetch_support(const t_x& x, typename t_x::size_type i)
+{
+    x.prefetch(i);
+}
+
+template<class t_x>
+typename std::enable_if<!has_prefetch<t_x>::value>::type
+prefetch_support(const t_x&, typename t_x::size_type) {}
+
+// has_prefetch_rank<X>::value is true if class X implements
+// the method prefetch_rank(i)
+template<typename t_x>
+struct has_prefetch_rank {
+    template<typename T>
+    static constexpr auto check(T*)
+    -> typename
+    std::is_same<
+    decltype(std::declval<const T>().prefetch_rank(
+                 std::declval<typename T::size_type>()
+             )),
+             void>::type {return std::true_type();}
+             template<typename>
+    static constexpr std::false_type check(...) {return std::false_type();}
+    typedef decltype(check<t_x>(nullptr)) type;
+    static constexpr bool value = type::value;
+};
+
+//! Prefetches the memory accessed by the first rank of wt.rank(i, c), if the wavelet tree supports it.
+template<class t_wt>
+typename std::enable_if<has_prefetch_rank<t_wt>::value>::type
+prefetch_rank(const t_wt& wt, typename t_wt::size_type i)
+{
+    wt.prefetch_rank(i);
+}
+
+template<class t_wt>
+typename std::enable_if<!has_prefetch_rank<t_wt>::value>::type
+prefetch_rank(const t_wt&, typename t_wt::size_type) {}
+
 struct pc_node {
     uint64_t  freq;     // frequency of symbol sym
     uint64_t  sym;      // symbol
@@ -88,8 +88,6 @@ class wt_int
         select_1_type          m_tree_select1; // select support for the wavelet tree bit vector
         select_0_type          m_tree_select0;
         uint32_t               m_max_level = 0;
-        mutable int_vector<64> m_path_off;     // array keeps track of path offset in select-like methods
-        mutable int_vector<64> m_path_rank_off;// array keeps track of rank values for the offsets
 
         void copy(const wt_int& wt) {
             m_size          = wt.m_size;
@@ -102,17 +100,10 @@ class wt_int
             m_tree_select0  = wt.m_tree_select0;
             m_tree_select0.set_vector(&m_tree);
             m_max_level     = wt.m_max_level;
-            m_path_off      = wt.m_path_off;
-            m_path_rank_off = wt.m_path_rank_off;
         }
 
     private:
 
-        void init_buffers(uint32_t max_level) {
-            m_path_off = int_vector<64>(max_level+1);
-            m_path_rank_off = int_vector<64>(max_level+1);
-        }
-
         // recursive internal version of the method interval_symbols
         void _interval_symbols(size_type i, size_type j, size_type& k,
                                std::vector<value_type>& cs,
@@ -162,9 +153,7 @@ class wt_int
         const uint32_t&        max_level = m_max_level; //!< Maximal level of the wavelet tree.
 
         //! Default constructor
-        wt_int() {
-            init_buffers(m_max_level);
-        };
+        wt_int() {};
 
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wt_int should be build.
@@ -175,11 +164,12 @@ class wt_int
          *        I.e. we need \Order{n\log n} if rac is a permutation of 0..n-1.
          *    \par Space complexity
          *        \f$ n\log|\Sigma| + O(1)\f$ bits, where \f$n=size\f$.
+         *        If construct_config::num_threads > 1 and n is large, the levels are
+         *        partitioned in parallel in memory, which takes \f$ 2n\log|\Sigma|\f$ bits.
          */
         template<uint8_t int_width>
         wt_int(int_vector_buffer<int_width>& buf, size_type size,
                uint32_t max_level=0) : m_size(size) {
-            init_buffers(m_max_level);
             if (0 == m_size)
                 return;
             size_type n = buf.size();  // set n
@@ -202,69 +192,77 @@ class wt_int
             } else {
                 m_max_level = max_level;
             }
-            init_buffers(m_max_level);
-
-            // buffer for elements in the right node
-            int_vector_buffer<> buf1(tmp_file(buf.filename(), "_wt_constr_buf"),
-                                     std::ios::out, 10*(1<<20), buf.width());
-            std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
-            osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary|
-                                   std::ios::trunc|std::ios::out);
-
-            size_type bit_size = m_size*m_max_level;
-            tree_out_buf.write((char*) &bit_size, sizeof(bit_size));// write size of bit_vector
-
-            size_type tree_pos = 0;
-            uint64_t tree_word = 0;
-
-            uint64_t mask_old = 1ULL<<(m_max_level);
-            for (uint32_t k=0; k<m_max_level; ++k) {
-                size_type          start     = 0;
-                const uint64_t    mask_new = 1ULL<<(m_max_level-k-1);
-                do {
-                    size_type i           = start;
-                    size_type cnt0        = 0;
-                    size_type cnt1        = 0;
-                    uint64_t  start_value = (rac[i]&mask_old);
-                    uint64_t  x;
-                    while (i < m_size and((x=rac[i])&mask_old)==start_value) {
-                        if (x&mask_new) {
-                            tree_word |= (1ULL << (tree_pos&0x3FULL));
-                            buf1[cnt1++] = x;
-                        } else {
-                            rac[start + cnt0++ ] = x;
-                        }
-                        ++tree_pos;
-                        if ((tree_pos & 0x3FULL) == 0) { // if tree_pos % 64 == 0 write old word
-                            tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
-                            tree_word = 0;
+
+            bit_vector tree;
+            uint64_t threads = wt_construct_threads(m_size);
+            if (threads > 1) {
+                tree = bit_vector(m_size*m_max_level, 0);
+                int_vector<64> zero_cnt(m_max_level, 0);
+                m_sigma = construct_int_levels(rac, tree, m_max_level, true, zero_cnt, threads);
+            } else {
+                // buffer for elements in the right node
+                int_vector_buffer<> buf1(tmp_file(buf.filename(), "_wt_constr_buf"),
+                                         std::ios::out, 10*(1<<20), buf.width());
+                std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
+                osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary|
+                                       std::ios::trunc|std::ios::out);
+
+                size_type bit_size = m_size*m_max_level;
+                tree_out_buf.write((char*) &bit_size, sizeof(bit_size));// write size of bit_vector
+
+                size_type tree_pos = 0;
+                uint64_t tree_word = 0;
+
+                uint64_t mask_old = 1ULL<<(m_max_level);
+                for (uint32_t k=0; k<m_max_level; ++k) {
+                    size_type          start     = 0;
+                    const uint64_t    mask_new = 1ULL<<(m_max_level-k-1);
+                    do {
+                        size_type i           = start;
+                        size_type cnt0        = 0;
+                        size_type cnt1        = 0;
+                        uint64_t  start_value = (rac[i]&mask_old);
+                        uint64_t  x;
+                        while (i < m_size and((x=rac[i])&mask_old)==start_value) {
+                            if (x&mask_new) {
+                                tree_word |= (1ULL << (tree_pos&0x3FULL));
+                                buf1[cnt1++] = x;
+                            } else {
+                                rac[start + cnt0++ ] = x;
+                            }
+                            ++tree_pos;
+                            if ((tree_pos & 0x3FULL) == 0) { // if tree_pos % 64 == 0 write old word
+                                tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                                tree_word = 0;
+                            }
+                            ++i;
                         }
-                        ++i;
-                    }
-                    if (k+1 < m_max_level) { // inner node
-                        for (size_type j=0; j<cnt1; ++j) {
-                            rac[start+cnt0+j] = buf1[j];
+                        if (k+1 < m_max_level) { // inner node
+                            for (size_type j=0; j<cnt1; ++j) {
+                                rac[start+cnt0+j] = buf1[j];
+                            }
+                        } else { // leaf node
+                            m_sigma += (cnt0>0) + (cnt1>0); // increase sigma for each leaf
                         }
-                    } else { // leaf node
-                        m_sigma += (cnt0>0) + (cnt1>0); // increase sigma for each leaf
-                    }
-                    start += cnt0+cnt1;
-                } while (start < m_size);
-                mask_old += mask_new;
-            }
-            if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
-                tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                        start += cnt0+cnt1;
+                    } while (start < m_size);
+                    mask_old += mask_new;
+                }
+                if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
+                    tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                }
+                buf1.close(true); // remove temporary file
+                tree_out_buf.close();
+                load_from_file(tree, tree_out_buf_file_name);
+                sdsl::remove(tree_out_buf_file_name);
             }
-            buf1.close(true); // remove temporary file
-            tree_out_buf.close();
             rac.resize(0);
-            bit_vector tree;
-            load_from_file(tree, tree_out_buf_file_name);
-            sdsl::remove(tree_out_buf_file_name);
             m_tree = bit_vector_type(std::move(tree));
-            util::init_support(m_tree_rank, &m_tree);
-            util::init_support(m_tree_select0, &m_tree);
-            util::init_support(m_tree_select1, &m_tree);
+            parallel::invoke(threads, {
+                [&]() { util::init_support(m_tree_rank, &m_tree); },
+                [&]() { util::init_support(m_tree_select0, &m_tree); },
+                [&]() { util::init_support(m_tree_select1, &m_tree); }
+            });
         }
 
         //! Copy constructor
@@ -298,8 +296,6 @@ class wt_int
                 m_tree_select0  = std::move(wt.m_tree_select0);
                 m_tree_select0.set_vector(&m_tree);
                 m_max_level     = std::move(wt.m_max_level);
-                m_path_off      = std::move(wt.m_path_off);
-                m_path_rank_off = std::move(wt.m_path_rank_off);
             }
             return *this;
         }
@@ -314,8 +310,6 @@ class wt_int
                 util::swap_support(m_tree_select1, wt.m_tree_select1, &m_tree, &(wt.m_tree));
                 util::swap_support(m_tree_select0, wt.m_tree_select0, &m_tree, &(wt.m_tree));
                 std::swap(m_max_level,  wt.m_max_level);
-                m_path_off.swap(wt.m_path_off);
-                m_path_rank_off.swap(wt.m_path_rank_off);
             }
         }
 
@@ -395,8 +389,55 @@ class wt_int
             return i;
         };
 
+        //! Calculates rank(i, c) and rank(j, c) in one traversal of the path of c.
+        /*!
+         *  \param i The exclusive index of the first prefix range [0..i-1].
+         *  \param j The exclusive index of the second prefix range [0..j-1].
+         *  \param c The symbol to count the occurrences in the prefixes.
+         *  \returns Pair (rank(i, c), rank(j, c)).
+         *  \par Time complexity
+         *        \f$ \Order{\log |\Sigma|} \f$
+         *  \par Precondition
+         *       \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (((1ULL)<<(m_max_level))<=c) { // c is greater than any symbol in wt
+                return {0, 0};
+            }
+            size_type offset = 0;
+            uint64_t mask = (1ULL) << (m_max_level-1);
+            size_type node_size = m_size;
+            for (uint32_t k=0; k < m_max_level and j; ++k) {
+                size_type ones_before_o   = m_tree_rank(offset);
+                size_type ones_before_i   = m_tree_rank(offset + i) - ones_before_o;
+                // once the interval is empty only one rank per level is needed
+                size_type ones_before_j   = (i == j) ? ones_before_i : m_tree_rank(offset + j) - ones_before_o;
+                size_type ones_before_end = m_tree_rank(offset + node_size) - ones_before_o;
+                if (c & mask) { // search for a one at this level
+                    offset += (node_size - ones_before_end);
+                    node_size = ones_before_end;
+                    i = ones_before_i;
+                    j = ones_before_j;
+                } else { // search for a zero at this level
+                    node_size = (node_size - ones_before_end);
+                    i = (i-ones_before_i);
+                    j = (j-ones_before_j);
+                }
+                offset += m_size;
+                mask >>= 1;
+            }
+            return {i, j};
+        };
+
 
 
+        //! Prefetches the memory accessed by the rank on the first level of rank(i, c).
+        void prefetch_rank(size_type i)const {
+            prefetch_support(m_tree_rank, i);
+        }
+
         //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
         /*!
          *  \param i The index of the symbol.
@@ -444,11 +485,13 @@ class wt_int
             size_type offset = 0;
             uint64_t mask    = (1ULL) << (m_max_level-1);
             size_type node_size = m_size;
-            m_path_off[0] = m_path_rank_off[0] = 0;
+            // path offsets and their ranks; local, so that concurrent queries are safe
+            size_type path_off[65], path_rank_off[65];
+            path_off[0] = path_rank_off[0] = 0;
 
             for (uint32_t k=0; k < m_max_level and node_size; ++k) {
                 size_type ones_before_o   = m_tree_rank(offset);
-                m_path_rank_off[k] = ones_before_o;
+                path_rank_off[k] = ones_before_o;
                 size_type ones_before_end = m_tree_rank(offset + node_size) - ones_before_o;
                 if (c & mask) { // search for a one at this level
                     offset += (node_size - ones_before_end);
@@ -457,7 +500,7 @@ class wt_int
                     node_size = (node_size - ones_before_end);
                 }
                 offset += m_size;
-                m_path_off[k+1] = offset;
+                path_off[k+1] = offset;
                 mask >>= 1;
             }
             if (0ULL == node_size or node_size < i) {
@@ -466,8 +509,8 @@ class wt_int
             }
             mask = 1ULL;
             for (uint32_t k=m_max_level; k>0; --k) {
-                offset = m_path_off[k-1];
-                size_type ones_before_o = m_path_rank_off[k-1];
+                offset = path_off[k-1];
+                size_type ones_before_o = path_rank_off[k-1];
                 if (c & mask) { // right child => search i'th
                     i = m_tree_select1(ones_before_o + i) - offset + 1;
                 } else { // left child => search i'th zero
@@ -727,7 +770,6 @@ class wt_int
             m_tree_select1.load(in, &m_tree);
             m_tree_select0.load(in, &m_tree);
             read_member(m_max_level, in);
-            init_buffers(m_max_level);
         }
 
         //! Represents a node in the wavelet tree
@@ -78,12 +78,6 @@ class wt_pc
 
     private:
 
-#ifdef WT_PC_CACHE
-        mutable value_type m_last_access_answer;
-        mutable size_type  m_last_access_i;
-        mutable size_type  m_last_access_rl;
-#endif
-
         size_type        m_size  = 0;    // original text size
         size_type        m_sigma = 0;    // alphabet size
         bit_vector_type  m_bv;           // bit vector to store the wavelet tree
@@ -105,21 +99,117 @@ class wt_pc
             m_tree          = wt.m_tree;
         }
 
-        // insert a character into the wavelet tree, see construct method
+        // insert a character into the wavelet tree, see construct method. If node_begin
+        // is not null, [node_begin[v]..node_end[v]) is the part of node v written by the
+        // calling thread; only its border words are shared with other threads.
         void insert_char(value_type old_chr, std::vector<uint64_t>& bv_node_pos,
-                         size_type times, bit_vector& bv) {
+                         size_type times, bit_vector& bv,
+                         const uint64_t* node_begin, const uint64_t* node_end) {
             uint64_t p = m_tree.bit_path(old_chr);
             uint32_t path_len = p>>56;
             node_type v = m_tree.root();
             for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
                 if (p&1) {
-                    bv.set_int(bv_node_pos[v], 0xFFFFFFFFFFFFFFFFULL,times);
+                    if (node_begin) {
+                        parallel::or_bits_in_range(bv.data(), node_begin[v], node_end[v], bv_node_pos[v], bits::lo_set[times], times);
+                    } else {
+                        bv.set_int(bv_node_pos[v], 0xFFFFFFFFFFFFFFFFULL,times);
+                    }
                 }
                 bv_node_pos[v] += times;
                 v = m_tree.child(v, p&1);
             }
         }
 
+        // inserts text[begin..end) into the nodes; runs of equal symbols are inserted together
+        template<class t_text>
+        void insert_chars(t_text& text, size_type begin, size_type end,
+                          std::vector<uint64_t>& bv_node_pos, bit_vector& bv,
+                          const uint64_t* node_begin=nullptr, const uint64_t* node_end=nullptr) {
+            if (begin >= end)
+                return;
+            value_type old_chr = text[begin];
+            uint32_t times = 0;
+            for (size_type i=begin; i < end; ++i) {
+                value_type chr = text[i];
+                if (chr != old_chr) {
+                    insert_char(old_chr, bv_node_pos, times, bv, node_begin, node_end);
+                    times = 1;
+                    old_chr = chr;
+                } else { // chr == old_chr
+                    ++times;
+                    if (times == 64) {
+                        insert_char(old_chr, bv_node_pos, times, bv, node_begin, node_end);
+                        times = 0;
+                    }
+                }
+            }
+            if (times > 0) {
+                insert_char(old_chr, bv_node_pos, times, bv, node_begin, node_end);
+            }
+        }
+
+        // parallel version of steps 1-4 of the constructor, which builds the
+        // same bit sequence. Each thread inserts a range of the text; its
+        // start positions in the nodes are determined by the symbol counts of
+        // the preceding ranges.
+        void construct_parallel(int_vector_buffer<tree_strat_type::int_width>& input_buf,
+                                uint64_t threads, bit_vector& temp_bv) {
+            int_vector<tree_strat_type::int_width> text(m_size, 0, input_buf.width());
+            for (size_type i=0; i < m_size; ++i) {
+                text[i] = input_buf[i];
+            }
+            std::vector<size_type> bounds(threads+1, 0);
+            for (uint64_t t=0; t <= threads; ++t) {
+                bounds[t] = (m_size*t)/threads;
+            }
+            // 1. Count occurrences of characters in each range
+            std::vector<std::vector<size_type>> C_range(threads);
+            parallel::run(threads, [&](uint64_t t) {
+                for (size_type i=bounds[t]; i < bounds[t+1]; ++i) {
+                    uint64_t c = text[i];
+                    if (c >= C_range[t].size()) { C_range[t].resize(c+1, 0); }
+                    ++C_range[t][c];
+                }
+            });
+            std::vector<size_type> C;
+            for (auto& Ct : C_range) {
+                if (Ct.size() > C.size()) { C.resize(Ct.size(), 0); }
+                for (size_type c=0; c < Ct.size(); ++c) {
+                    C[c] += Ct[c];
+                }
+            }
+            // 2. Calculate effective alphabet size
+            calculate_effective_alphabet_size(C, m_sigma);
+            // 3. Generate tree shape
+            temp_bv = bit_vector(construct_tree_shape(C), 0);
+            // 4. Generate wavelet tree bit sequence
+            // bv_node_pos[t][v] is the start of thread t in node v and the end of thread t-1
+            std::vector<std::vector<uint64_t>> bv_node_pos(threads+1, std::vector<uint64_t>(m_tree.size(), 0));
+            for (size_type v=0; v < m_tree.size(); ++v) {
+                bv_node_pos[0][v] = m_tree.bv_pos(v);
+            }
+            for (uint64_t t=1; t <= threads; ++t) {
+                bv_node_pos[t] = bv_node_pos[t-1];
+                for (size_type c=0; c < C_range[t-1].size(); ++c) {
+                    if (C_range[t-1][c] == 0)
+                        continue;
+                    uint64_t p = m_tree.bit_path(c);
+                    uint32_t path_len = p>>56;
+                    node_type v = m_tree.root();
+                    for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
+                        bv_node_pos[t][v] += C_range[t-1][c];
+                        v = m_tree.child(v, p&1);
+                    }
+                }
+            }
+            parallel::run(threads, [&](uint64_t t) {
+                std::vector<uint64_t> pos = bv_node_pos[t];
+                insert_chars(text, bounds[t], bounds[t+1], pos, temp_bv,
+                             bv_node_pos[t].data(), bv_node_pos[t+1].data());
+            });
+        }
+
 
 
         // calculates the tree shape returns the size of the WT bit vector
@@ -135,10 +225,12 @@ class wt_pc
             return bv_size;
         }
 
-        void construct_init_rank_select() {
-            util::init_support(m_bv_rank, &m_bv);
-            util::init_support(m_bv_select0, &m_bv);
-            util::init_support(m_bv_select1, &m_bv);
+        void construct_init_rank_select(uint64_t threads=1) {
+            parallel::invoke(threads, {
+                [&]() { util::init_support(m_bv_rank, &m_bv); },
+                [&]() { util::init_support(m_bv_select0, &m_bv); },
+                [&]() { util::init_support(m_bv_select1, &m_bv); }
+            });
         }
 
         // recursive internal version of the method interval_symbols
@@ -192,6 +284,10 @@ class wt_pc
          * \param size         The length of the prefix.
          * \par Time complexity
          *      \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
+         *
+         * If construct_config::num_threads > 1 and n is large, the input is
+         * loaded into memory and ranges of it are inserted into the nodes
+         * in parallel.
          */
         wt_pc(int_vector_buffer<tree_strat_type::int_width>& input_buf,
               size_type size):m_size(size) {
@@ -201,47 +297,35 @@ class wt_pc
             // TODO: C should also depend on the tree_strategy. C is just a mapping
             // from a symbol to its frequency. So a map<uint64_t,uint64_t> could be
             // used for integer alphabets...
-            std::vector<size_type> C;
-            // 1. Count occurrences of characters
-            calculate_character_occurences(input_buf, m_size, C);
-            // 2. Calculate effective alphabet size
-            calculate_effective_alphabet_size(C, m_sigma);
-            // 3. Generate tree shape
-            size_type tree_size = construct_tree_shape(C);
-            // 4. Generate wavelet tree bit sequence m_bv
-            bit_vector temp_bv(tree_size, 0);
-
-            // Initializing starting position of wavelet tree nodes
-            std::vector<uint64_t> bv_node_pos(m_tree.size(), 0);
-            for (size_type v=0; v < m_tree.size(); ++v) {
-                bv_node_pos[v] = m_tree.bv_pos(v);
-            }
             if (input_buf.size() < size) {
                 throw std::logic_error("Stream size is smaller than size!");
                 return;
             }
-            value_type old_chr = input_buf[0];
-            uint32_t times = 0;
-            for (size_type i=0; i < m_size; ++i) {
-                value_type chr = input_buf[i];
-                if (chr != old_chr) {
-                    insert_char(old_chr, bv_node_pos, times, temp_bv);
-                    times = 1;
-                    old_chr = chr;
-                } else { // chr == old_chr
-                    ++times;
-                    if (times == 64) {
-                        insert_char(old_chr, bv_node_pos, times, temp_bv);
-                        times = 0;
-                    }
+            bit_vector temp_bv;
+            uint64_t threads = wt_construct_threads(m_size);
+            if (threads > 1) {
+                construct_parallel(input_buf, threads, temp_bv);
+            } else {
+                std::vector<size_type> C;
+                // 1. Count occurrences of characters
+                calculate_character_occurences(input_buf, m_size, C);
+                // 2. Calculate effective alphabet size
+                calculate_effective_alphabet_size(C, m_sigma);
+                // 3. Generate tree shape
+                size_type tree_size = construct_tree_shape(C);
+                // 4. Generate wavelet tree bit sequence m_bv
+                temp_bv = bit_vector(tree_size, 0);
+
+                // Initializing starting position of wavelet tree nodes
+                std::vector<uint64_t> bv_node_pos(m_tree.size(), 0);
+                for (size_type v=0; v < m_tree.size(); ++v) {
+                    bv_node_pos[v] = m_tree.bv_pos(v);
                 }
-            }
-            if (times > 0) {
-                insert_char(old_chr, bv_node_pos, times, temp_bv);
+                insert_chars(input_buf, 0, m_size, bv_node_pos, temp_bv);
             }
             m_bv = bit_vector_type(std::move(temp_bv));
             // 5. Initialize rank and select data structures for m_bv
-            construct_init_rank_select();
+            construct_init_rank_select(threads);
             // 6. Finish inner nodes by precalculating the bv_pos_rank values
             m_tree.init_node_ranks(m_bv_rank);
         }
@@ -371,6 +455,53 @@ class wt_pc
             return result;
         };
 
+        //! Calculates rank(i, c) and rank(j, c) in one traversal of the path of c.
+        /*!
+         * \param i Exclusive right bound of the first range.
+         * \param j Exclusive right bound of the second range.
+         * \param c Symbol c.
+         * \return Pair (rank(i, c), rank(j, c)).
+         * \par Time complexity
+         *      \f$ \Order{H_0} \f$ on average, where \f$ H_0 \f$ is the
+         *      zero order entropy of the sequence
+         *
+         * \par Precondition
+         *      \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (!m_tree.is_valid(m_tree.c_to_leaf(c))) {
+                return {0, 0};  // if `c` was not in the text
+            }
+            if (m_sigma == 1) {
+                return {i, j};
+            }
+            uint64_t p = m_tree.bit_path(c);
+            uint32_t path_len = (p>>56);
+            node_type v = m_tree.root();
+            for (uint32_t l=0; l<path_len and j; ++l, p >>= 1) {
+                size_type pos_rank = m_tree.bv_pos_rank(v);
+                size_type ones_i = m_bv_rank(m_tree.bv_pos(v)+i) - pos_rank;
+                // once the interval is empty only one rank per level is needed
+                size_type ones_j = (i == j) ? ones_i : m_bv_rank(m_tree.bv_pos(v)+j) - pos_rank;
+                if (p&1) {
+                    i = ones_i;
+                    j = ones_j;
+                } else {
+                    i -= ones_i;
+                    j -= ones_j;
+                }
+                v = m_tree.child(v, p&1); // goto child
+            }
+            return {i, j};
+        };
+
+        //! Prefetches the memory accessed by the rank on the first level of rank(i, c).
+        void prefetch_rank(size_type i)const {
+            prefetch_support(m_bv_rank, m_tree.bv_pos(m_tree.root())+i);
+        }
+
         //! Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
         /*!
          * \param i The index of the symbol.
@@ -161,6 +161,20 @@ class wt_rlmn
             m_C_bf_rank     = wt.m_C_bf_rank;
         }
 
+        // Calculates rank(i, c) from wt_ex_pos = m_bl_rank(i) and
+        // c_runs = m_wt.rank(wt_ex_pos, c)
+        size_type rank_from_runs(size_type i, size_type wt_ex_pos,
+                                 size_type c_runs, value_type c)const {
+            if (c_runs == 0)
+                return 0;
+            if (m_wt[wt_ex_pos-1] == c) {
+                size_type c_run_begin = m_bl_select(wt_ex_pos);
+                return m_bf_select(m_C_bf_rank[c]+c_runs)-m_C[c]+i-c_run_begin;
+            } else {
+                return m_bf_select(m_C_bf_rank[c] + c_runs + 1) - m_C[c];
+            }
+        }
+
     public:
 
         const size_type& sigma = m_wt.sigma;
@@ -335,15 +349,34 @@ class wt_rlmn
             if (i == 0)
                 return 0;
             size_type wt_ex_pos = m_bl_rank(i);
-            size_type c_runs = m_wt.rank(wt_ex_pos, c);
-            if (c_runs == 0)
-                return 0;
-            if (m_wt[wt_ex_pos-1] == c) {
-                size_type c_run_begin = m_bl_select(wt_ex_pos);
-                return m_bf_select(m_C_bf_rank[c]+c_runs)-m_C[c]+i-c_run_begin;
-            } else {
-                return m_bf_select(m_C_bf_rank[c] + c_runs + 1) - m_C[c];
+            return rank_from_runs(i, wt_ex_pos, m_wt.rank(wt_ex_pos, c), c);
+        };
+
+        //! Calculates rank(i, c) and rank(j, c) with one fused rank on the run heads.
+        /*!
+         *  \param i Exclusive right bound of the first range.
+         *  \param j Exclusive right bound of the second range.
+         *  \param c Symbol c.
+         *  \return Pair (rank(i, c), rank(j, c)).
+         *  \par Time complexity
+         *        \f$ \Order{H_0} \f$ on average, where \f$ H_0 \f$ is the
+         *        zero order entropy of the sequence
+         *  \par Precondition
+         *       \f$ i \leq j \leq size() \f$
+         */
+        std::pair<size_type, size_type>
+        rank_pair(size_type i, size_type j, value_type c)const {
+            assert(i <= j and j <= size());
+            if (j == 0)
+                return {0, 0};
+            size_type ex_i = m_bl_rank(i);
+            size_type ex_j = (i == j) ? ex_i : m_bl_rank(j);
+            auto c_runs = sdsl::rank_pair(m_wt, ex_i, ex_j, c);
+            size_type rank_i = rank_from_runs(i, ex_i, c_runs.first, c);
+            if (ex_i == ex_j) { // no run starts in [i..j)
+                return {rank_i, rank_i + ((m_wt[ex_j-1] == c) ? j-i : 0)};
             }
+            return {rank_i, rank_from_runs(j, ex_j, c_runs.second, c)};
         };
 
         //! Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
@@ -15,10 +15,368 @@
     along with this program.  If not, see http://www.gnu.org/licenses/ .
 */
 #include "sdsl/bits.hpp"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SDSL_X86_DISPATCH
+#endif
 
 namespace sdsl
 {
 
+namespace
+{
+
+uint64_t cnt_portable(const uint64_t* data, uint64_t n)
+{
+    uint64_t res = 0;
+    for (uint64_t i=0; i < n; ++i) {
+        res += bits::cnt(data[i]);
+    }
+    return res;
+}
+
+#ifdef SDSL_X86_DISPATCH
+__attribute__((target("popcnt")))
+uint64_t cnt_popcnt(const uint64_t* data, uint64_t n)
+{
+    uint64_t res = 0;
+    for (uint64_t i=0; i < n; ++i) {
+        res += __builtin_popcountll(data[i]);
+    }
+    return res;
+}
+
+// Nibble lookup with vpshufb, see Mula, Kurz, and Lemire: Faster Population
+// Counts Using AVX2 Instructions. The Computer Journal 61(1), 2018.
+__attribute__((target("avx2,popcnt")))
+uint64_t cnt_avx2(const uint64_t* data, uint64_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    uint64_t i = 0;
+    while (i+4 <= n) {
+        // byte counters hold at most 31*8 < 256
+        __m256i local = zero;
+        for (uint64_t k=0; k < 31 and i+4 <= n; ++k, i+=4) {
+            __m256i v  = _mm256_loadu_si256((const __m256i*)(data+i));
+            __m256i lo = _mm256_and_si256(v, low_mask);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            local = _mm256_add_epi8(local, _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                    _mm256_shuffle_epi8(lookup, hi)));
+        }
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(local, zero));
+    }
+    uint64_t res = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1)
+                   + _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    for (; i < n; ++i) {
+        res += __builtin_popcountll(data[i]);
+    }
+    return res;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+uint64_t cnt_avx512(const uint64_t* data, uint64_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    uint64_t i = 0;
+    for (; i+8 <= n; i+=8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(data+i)));
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U<<(n-i))-1);
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, data+i)));
+    }
+    // the reduce and extract intrinsics trigger -Wuninitialized in GCC 12
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512((__m512i*)lanes, acc);
+    uint64_t res = 0;
+    for (uint64_t k=0; k < 8; ++k) {
+        res += lanes[k];
+    }
+    return res;
+}
+#endif
+
+// Kernels for blocks of 64 values of width t_len, which occupy t_len words
+template<uint8_t t_len>
+void read_block(const uint64_t* data, uint64_t* out)
+{
+    const uint64_t mask = t_len == 64 ? ~0ULL : (1ULL << (t_len & 0x3F)) - 1;
+#pragma GCC unroll 64
+    for (uint32_t k=0; k < 64; ++k) {
+        const uint32_t i = (k*t_len) >> 6, o = (k*t_len) & 0x3F;
+        uint64_t x = data[i] >> o;
+        if (o + t_len > 64) {
+            x |= data[i+1] << (64-o);
+        }
+        out[k] = x & mask;
+    }
+}
+
+template<uint8_t t_len>
+void write_block(uint64_t* data, const uint64_t* in)
+{
+    const uint64_t mask = t_len == 64 ? ~0ULL : (1ULL << (t_len & 0x3F)) - 1;
+    std::memset(data, 0, t_len*sizeof(uint64_t));
+#pragma GCC unroll 64
+    for (uint32_t k=0; k < 64; ++k) {
+        const uint32_t i = (k*t_len) >> 6, o = (k*t_len) & 0x3F;
+        const uint64_t x = in[k] & mask;
+        data[i] |= x << o;
+        if (o + t_len > 64) {
+            data[i+1] |= x >> (64-o);
+        }
+    }
+}
+
+// Byte aligned widths are widened and narrowed element-wise, which the
+// compiler vectorizes
+template<class t_uint>
+void read_block_aligned(const uint64_t* data, uint64_t* out)
+{
+    const char* p = (const char*)data;
+    for (uint32_t k=0; k < 64; ++k) {
+        t_uint x;
+        std::memcpy(&x, p + k*sizeof(t_uint), sizeof(t_uint));
+        out[k] = x;
+    }
+}
+
+template<class t_uint>
+void write_block_aligned(uint64_t* data, const uint64_t* in)
+{
+    char* p = (char*)data;
+    for (uint32_t k=0; k < 64; ++k) {
+        t_uint x = (t_uint)in[k];
+        std::memcpy(p + k*sizeof(t_uint), &x, sizeof(t_uint));
+    }
+}
+
+template<> void read_block<8>(const uint64_t* data, uint64_t* out) { read_block_aligned<uint8_t>(data, out); }
+template<> void read_block<16>(const uint64_t* data, uint64_t* out) { read_block_aligned<uint16_t>(data, out); }
+template<> void read_block<32>(const uint64_t* data, uint64_t* out) { read_block_aligned<uint32_t>(data, out); }
+template<> void read_block<64>(const uint64_t* data, uint64_t* out) { std::memcpy(out, data, 64*sizeof(uint64_t)); }
+template<> void write_block<8>(uint64_t* data, const uint64_t* in) { write_block_aligned<uint8_t>(data, in); }
+template<> void write_block<16>(uint64_t* data, const uint64_t* in) { write_block_aligned<uint16_t>(data, in); }
+template<> void write_block<32>(uint64_t* data, const uint64_t* in) { write_block_aligned<uint32_t>(data, in); }
+template<> void write_block<64>(uint64_t* data, const uint64_t* in) { std::memcpy(data, in, 64*sizeof(uint64_t)); }
+
+#ifdef SDSL_X86_DISPATCH
+__attribute__((target("avx2")))
+void read_block8_avx2(const uint64_t* data, uint64_t* out)
+{
+    const char* p = (const char*)data;
+    for (uint32_t k=0; k < 64; k+=8) {
+        __m128i x = _mm_loadl_epi64((const __m128i*)(p+k));
+        _mm256_storeu_si256((__m256i*)(out+k), _mm256_cvtepu8_epi64(x));
+        _mm256_storeu_si256((__m256i*)(out+k+4), _mm256_cvtepu8_epi64(_mm_srli_si128(x, 4)));
+    }
+}
+
+__attribute__((target("avx2")))
+void read_block16_avx2(const uint64_t* data, uint64_t* out)
+{
+    const char* p = (const char*)data;
+    for (uint32_t k=0; k < 64; k+=8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p+2*k));
+        _mm256_storeu_si256((__m256i*)(out+k), _mm256_cvtepu16_epi64(x));
+        _mm256_storeu_si256((__m256i*)(out+k+4), _mm256_cvtepu16_epi64(_mm_srli_si128(x, 8)));
+    }
+}
+
+__attribute__((target("avx2")))
+void read_block32_avx2(const uint64_t* data, uint64_t* out)
+{
+    const char* p = (const char*)data;
+    for (uint32_t k=0; k < 64; k+=8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p+4*k));
+        _mm256_storeu_si256((__m256i*)(out+k), _mm256_cvtepu32_epi64(_mm256_castsi256_si128(x)));
+        _mm256_storeu_si256((__m256i*)(out+k+4), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+}
+
+__attribute__((target("avx2")))
+void write_block32_avx2(uint64_t* data, const uint64_t* in)
+{
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    char* p = (char*)data;
+    for (uint32_t k=0; k < 64; k+=4) {
+        __m256i x = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)(in+k)), even);
+        _mm_storeu_si128((__m128i*)(p+4*k), _mm256_castsi256_si128(x));
+    }
+}
+#endif
+
+typedef void (*read_block_type)(const uint64_t*, uint64_t*);
+typedef void (*write_block_type)(uint64_t*, const uint64_t*);
+
+template<uint8_t t_len>
+struct block_kernels {
+    static void fill(read_block_type* r, write_block_type* w)
+    {
+        r[t_len] = read_block<t_len>;
+        w[t_len] = write_block<t_len>;
+        block_kernels<t_len-1>::fill(r, w);
+    }
+};
+
+template<>
+struct block_kernels<0> {
+    static void fill(read_block_type*, write_block_type*) {}
+};
+
+// Portable block kernels indexed by width
+struct block_kernel_table {
+    read_block_type  read[65];
+    write_block_type write[65];
+
+    block_kernel_table()
+    {
+        read[0] = nullptr;
+        write[0] = nullptr;
+        block_kernels<64>::fill(read, write);
+    }
+};
+
+const block_kernel_table& block_kernels_portable()
+{
+    static block_kernel_table table;
+    return table;
+}
+
+read_block_type read_kernel(uint8_t len)
+{
+#ifdef SDSL_X86_DISPATCH
+    if (bits::cpu_features & bits::CPU_AVX2) {
+        switch (len) {
+            case 8:  return read_block8_avx2;
+            case 16: return read_block16_avx2;
+            case 32: return read_block32_avx2;
+        }
+    }
+#endif
+    return block_kernels_portable().read[len];
+}
+
+write_block_type write_kernel(uint8_t len)
+{
+#ifdef SDSL_X86_DISPATCH
+    if ((bits::cpu_features & bits::CPU_AVX2) and len == 32) {
+        return write_block32_avx2;
+    }
+#endif
+    return block_kernels_portable().write[len];
+}
+
+}
+
+uint32_t bits::detect_cpu_features()
+{
+    uint32_t features = 0;
+#ifdef SDSL_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) {
+        features |= CPU_POPCNT;
+    }
+    // pdep and pext are microcoded and slower than the broadword select on AMD Zen 1 and 2
+    if (__builtin_cpu_supports("bmi2") and !__builtin_cpu_is("znver1") and !__builtin_cpu_is("znver2")) {
+        features |= CPU_BMI2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        features |= CPU_AVX2;
+    }
+    if (__builtin_cpu_supports("avx512vpopcntdq")) {
+        features |= CPU_AVX512_VPOPCNTDQ;
+    }
+#endif
+    return features;
+}
+
+// Zero until the dynamic initialization is done, i.e. earlier calls use the portable methods
+uint32_t bits::cpu_features = bits::detect_cpu_features();
+
+uint64_t bits::cnt(const uint64_t* data, uint64_t n)
+{
+#ifdef SDSL_X86_DISPATCH
+    if (n >= 8) {
+        if (cpu_features & CPU_AVX512_VPOPCNTDQ) {
+            return cnt_avx512(data, n);
+        }
+        if ((cpu_features & CPU_AVX2) and (cpu_features & CPU_POPCNT)) {
+            return cnt_avx2(data, n);
+        }
+    }
+    if (cpu_features & CPU_POPCNT) {
+        return cnt_popcnt(data, n);
+    }
+#endif
+    return cnt_portable(data, n);
+}
+
+#ifdef SDSL_X86_DISPATCH
+__attribute__((target("bmi,bmi2")))
+uint32_t bits::sel_bmi2(uint64_t x, uint32_t i)
+{
+    return _tzcnt_u64(_pdep_u64(1ULL<<(i-1), x));
+}
+#else
+uint32_t bits::sel_bmi2(uint64_t x, uint32_t i)
+{
+    return _sel(x, i);
+}
+#endif
+
+void bits::read_ints(const uint64_t* data, uint64_t idx, uint8_t len, uint64_t n, uint64_t* out)
+{
+    if (len == 0) {
+        std::fill(out, out+n, 0);
+        return;
+    }
+    const uint64_t* word = data + (idx >> 6);
+    uint8_t offset = idx & 0x3F;
+    uint64_t i = 0;
+    // values up to the first one which starts at a word boundary
+    for (; i < n and i < 64 and offset != 0; ++i) {
+        *out++ = read_int_and_move(word, offset, len);
+    }
+    if (offset == 0 and i+64 <= n) {
+        read_block_type kernel = read_kernel(len);
+        for (; i+64 <= n; i+=64, word+=len, out+=64) {
+            kernel(word, out);
+        }
+    }
+    for (; i < n; ++i) {
+        *out++ = read_int_and_move(word, offset, len);
+    }
+}
+
+void bits::write_ints(uint64_t* data, uint64_t idx, uint8_t len, uint64_t n, const uint64_t* in)
+{
+    if (len == 0) {
+        return;
+    }
+    uint64_t* word = data + (idx >> 6);
+    uint8_t offset = idx & 0x3F;
+    uint64_t i = 0;
+    for (; i < n and i < 64 and offset != 0; ++i) {
+        write_int_and_move(word, *in++, offset, len);
+    }
+    if (offset == 0 and i+64 <= n) {
+        write_block_type kernel = write_kernel(len);
+        for (; i+64 <= n; i+=64, word+=len, in+=64) {
+            kernel(word, in);
+        }
+    }
+    for (; i < n; ++i) {
+        write_int_and_move(word, *in++, offset, len);
+    }
+}
+
 const uint8_t bits::lt_cnt[] = {
     0, 1, 1, 2, 1, 2, 2, 3,
     1, 2, 2, 3, 2, 3, 3, 4,
@@ -0,0 +1,104 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+*/
+#include "sdsl/construct_bwt.hpp"
+#include "sdsl/wt_huff.hpp"
+#include "sdsl/sfstream.hpp"
+#include "divsufsort.h"
+#include "divsufsort64.h"
+#include <algorithm>
+#include <string>
+
+namespace sdsl
+{
+
+void construct_bwt_sa_free(cache_config& config)
+{
+    typedef int_vector<>::size_type size_type;
+    int_vector<8> text;
+    load_from_cache(text, conf::KEY_TEXT, config);
+    size_type n = text.size();
+
+    int_vector_buffer<8> bwt_buf(cache_file_name(conf::KEY_BWT, config), std::ios::out);
+    if (n <= 1) {
+        for (size_type i=0; i < n; ++i) {
+            bwt_buf[i] = text[i];
+        }
+    } else {
+        // divbwt overwrites the text with the BWT of the rotations, from which the
+        // primary row (suffix 0) is removed and T[n-1] is written to position 0
+        unsigned char* c = (unsigned char*)text.data();
+        int64_t primary;
+        if (n < 0x7FFFFFFFULL) {
+            primary = divbwt(c, c, nullptr, n);
+        } else {
+            primary = divbwt64(c, c, nullptr, n);
+        }
+        if (primary < 0) {
+            throw std::logic_error("construct_bwt_sa_free: divbwt failed");
+        }
+        for (size_type i=1; i < (size_type)primary; ++i) {
+            bwt_buf[i-1] = text[i];
+        }
+        bwt_buf[primary-1] = text[0];
+        for (size_type i=primary; i < n; ++i) {
+            bwt_buf[i] = text[i];
+        }
+    }
+    bwt_buf.close();
+    register_cache_file(conf::KEY_BWT, config);
+}
+
+void construct_sa_samples(cache_config& config, uint64_t sa_sample_dens, uint64_t isa_sample_dens)
+{
+    typedef int_vector<>::size_type size_type;
+    int_vector_buffer<8> bwt_buf(cache_file_name(conf::KEY_BWT, config));
+    size_type n = bwt_buf.size();
+    std::vector<size_type> C(257, 0);
+    for (size_type i=0; i < n; ++i) {
+        ++C[bwt_buf[i]+1];
+    }
+    for (size_type i=1; i < C.size(); ++i) {
+        C[i] += C[i-1];
+    }
+    wt_huff<> wt(bwt_buf, n);
+    bwt_buf.close();
+
+    // (1) Walk backwards through the text and record the needed (row, SA) pairs
+    uint8_t log_n = bits::hi(std::max(n, (size_type)1))+1;
+    size_type max_samples = n/sa_sample_dens + n/sa_sample_dens + n/isa_sample_dens + 3;
+    int_vector<> rows(std::min(n, max_samples), 0, log_n);
+    int_vector<> sa_values(rows.size(), 0, log_n);
+    bit_vector marked(n, 0);
+    size_type cnt = 0;
+    for (size_type sa=n, row=0; sa > 0; --sa) {
+        if (row % sa_sample_dens == 0 or (sa-1) % sa_sample_dens == 0 or (sa-1) % isa_sample_dens == 0) {
+            marked[row] = 1;
+            rows[cnt] = row;
+            sa_values[cnt++] = sa-1;
+        }
+        auto rc = wt.inverse_select(row);
+        row = C[rc.second] + rc.first;
+    }
+    util::clear(wt);
+
+    // (2) Bring the SA values into row order
+    rank_support_v5<> rank_marked(&marked);
+    int_vector<> values(cnt, 0, log_n);
+    for (size_type i=0; i < cnt; ++i) {
+        values[rank_marked(rows[i])] = sa_values[i];
+    }
+    util::clear(rows);
+    util::clear(sa_values);
+
+    osfstream out(cache_file_name(conf::KEY_SA_SAMPLES, config), std::ios::binary | std::ios::trunc | std::ios::out);
+    if (!out) {
+        throw std::ios_base::failure("construct_sa_samples: Cannot open file for the SA samples");
+    }
+    marked.serialize(out);
+    values.serialize(out);
+    out.close();
+    register_cache_file(conf::KEY_SA_SAMPLES, config);
+}
+
+}// end namespace
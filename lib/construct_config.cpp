@@ -1,8 +1,187 @@
 #include "sdsl/construct_config.hpp"
+#include "sdsl/bits.hpp"
+#include "sdsl/util.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace sdsl
 {
 
 byte_sa_algo_type construct_config::byte_algo_sa = LIBDIVSUFSORT;
+int_sa_algo_type construct_config::int_algo_sa = QSUFSORT;
+lcp_algo_type construct_config::lcp_algo = LCP_SEMI_EXTERN_PHI;
+bwt_algo_type construct_config::bwt_algo = BWT_FROM_SA;
+uint64_t construct_config::num_threads = 1;
+bool construct_config::pipeline = false;
+bool construct_config::wm_semi_external = false;
+
+namespace
+{
+
+// The prefix doubling algorithm only pays off with many cores
+const uint64_t min_threads_parallel_sa = 16;
+// Size of the two int_vector_buffers used by the scans over SA and LCP
+const uint64_t scan_buffer_bytes = 2*4000000;
+
+template<class t_algo>
+struct candidate {
+    t_algo   algo;
+    uint64_t bytes;
+};
+
+// Returns the first candidate which fits or the one with the lowest space
+template<class t_algo>
+candidate<t_algo> choose(const std::vector<candidate<t_algo>>& candidates, uint64_t ram_budget)
+{
+    candidate<t_algo> smallest = candidates[0];
+    for (auto& c : candidates) {
+        if (c.bytes <= ram_budget) {
+            return c;
+        }
+        if (c.bytes < smallest.bytes) {
+            smallest = c;
+        }
+    }
+    return smallest;
+}
+
+std::string mib(uint64_t bytes)
+{
+    return util::to_string((bytes+(1ULL<<20)-1)>>20) + " MiB";
+}
+
+}
+
+construct_plan plan_construction(uint64_t n, uint8_t width, uint8_t text_width,
+                                 uint64_t ram_budget, uint64_t num_threads,
+                                 uint64_t sample_dens, bool sa_free)
+{
+    construct_plan plan;
+    plan.ram_budget = ram_budget;
+    const uint64_t log_n = bits::hi(std::max(n,(uint64_t)1))+1;
+    const uint64_t text_bytes = (n*text_width+7)/8;
+    const uint64_t n_log_n_bytes = (n*log_n+7)/8;
+    const bool parallel = num_threads >= min_threads_parallel_sa;
+    const uint64_t samples_bytes = sample_dens > 0 ? ((n/sample_dens+1)*log_n+7)/8 : 0;
+
+    // SA; candidates are ordered by speed
+    if (width == 8) {
+        std::vector<candidate<byte_sa_algo_type>> c;
+        if (parallel) {
+            c.push_back({PARALLEL_DOUBLING, text_bytes + 20*n});
+        }
+        c.push_back({LIBDIVSUFSORT, text_bytes + (n < 0x7FFFFFFFULL ? 4 : 8)*n});
+        c.push_back({SE_SAIS, text_bytes + std::min(n, n_log_n_bytes/2) + scan_buffer_bytes});
+        auto best = choose(c, ram_budget);
+        plan.byte_algo_sa = best.algo;
+        plan.sa_bytes = best.bytes;
+    } else {
+        std::vector<candidate<int_sa_algo_type>> c;
+        if (parallel) {
+            c.push_back({PARALLEL_DOUBLING_INT, text_bytes + 20*n});
+        }
+        c.push_back({QSUFSORT, 2*((n*(std::max((uint64_t)text_width, log_n)+1)+7)/8)});
+        c.push_back({SAIS_INT, text_bytes + n_log_n_bytes/2 + scan_buffer_bytes});
+        auto best = choose(c, ram_budget);
+        plan.int_algo_sa = best.algo;
+        plan.sa_bytes = best.bytes;
+    }
+
+    // BWT: text in memory, SA and BWT streamed
+    plan.bwt_bytes = text_bytes + scan_buffer_bytes;
+    // ISA: the samples are collected while the SA is streamed
+    plan.isa_bytes = sample_dens > 0 ? 2*samples_bytes + scan_buffer_bytes : 0;
+
+    // Without the SA the BWT is induced by divbwt and the samples are taken
+    // by LF walks over a temporary wt_huff (see construct_sa_samples). This
+    // is faster, since the SA is neither constructed nor streamed.
+    if (sa_free and width == 8 and sample_dens > 1) {
+        uint64_t bwt_bytes = (n < 0x7FFFFFFFULL ? 5 : 9)*n;
+        uint64_t isa_bytes = (n*(text_width+2)+7)/8 + 3*samples_bytes;
+        uint64_t from_sa = std::max(plan.sa_bytes, std::max(plan.bwt_bytes, plan.isa_bytes));
+        uint64_t free_sa = std::max(bwt_bytes, isa_bytes);
+        if (free_sa <= ram_budget or (from_sa > ram_budget and free_sa < from_sa)) {
+            plan.bwt_algo = BWT_SA_FREE;
+            plan.sa_bytes = 0;
+            plan.bwt_bytes = bwt_bytes;
+            plan.isa_bytes = isa_bytes;
+        }
+    }
+
+    // LCP; candidates are ordered by speed
+    {
+        std::vector<candidate<lcp_algo_type>> c;
+        if (num_threads > 1) {
+            c.push_back({LCP_PARALLEL_PHI, text_bytes + (n <= 0xFFFFFFFFULL ? 4 : 8)*n + n_log_n_bytes});
+        }
+        c.push_back({LCP_PHI, text_bytes + n_log_n_bytes + scan_buffer_bytes});
+        if (width == 8) {
+            c.push_back({LCP_GO, 2*n + scan_buffer_bytes});
+            c.push_back({LCP_SEMI_EXTERN_PHI, text_bytes + n*log_n/64 + scan_buffer_bytes});
+            c.push_back({LCP_BWT_BASED2, n + n/2 + scan_buffer_bytes});
+        }
+        auto best = choose(c, ram_budget);
+        plan.lcp_algo = best.algo;
+        plan.lcp_bytes = best.bytes;
+    }
+    return plan;
+}
+
+uint64_t construct_plan::peak_bytes() const
+{
+    return std::max(std::max(sa_bytes, bwt_bytes), std::max(isa_bytes, lcp_bytes));
+}
+
+void construct_plan::apply() const
+{
+    construct_config::byte_algo_sa = byte_algo_sa;
+    construct_config::int_algo_sa  = int_algo_sa;
+    construct_config::lcp_algo     = lcp_algo;
+    construct_config::bwt_algo     = bwt_algo;
+}
+
+std::string construct_plan::sa_info(uint8_t width) const
+{
+    std::string name;
+    if (width == 8) {
+        switch (byte_algo_sa) {
+            case LIBDIVSUFSORT:     name = "LIBDIVSUFSORT"; break;
+            case SE_SAIS:           name = "SE_SAIS"; break;
+            case PARALLEL_DOUBLING: name = "PARALLEL_DOUBLING"; break;
+        }
+    } else {
+        switch (int_algo_sa) {
+            case QSUFSORT:              name = "QSUFSORT"; break;
+            case SAIS_INT:              name = "SAIS_INT"; break;
+            case PARALLEL_DOUBLING_INT: name = "PARALLEL_DOUBLING_INT"; break;
+        }
+    }
+    return "SA " + name + " (estimated " + mib(sa_bytes) + ")";
+}
+
+std::string construct_plan::bwt_info() const
+{
+    std::string name = bwt_algo == BWT_SA_FREE ? "BWT_SA_FREE" : "BWT_FROM_SA";
+    return "BWT " + name + " (estimated " + mib(bwt_bytes) + ")";
+}
+
+std::string construct_plan::isa_info() const
+{
+    std::string name = bwt_algo == BWT_SA_FREE ? "LF walks" : "SA scan";
+    return "ISA samples by " + name + " (estimated " + mib(isa_bytes) + ")";
+}
+
+std::string construct_plan::lcp_info() const
+{
+    std::string name;
+    switch (lcp_algo) {
+        case LCP_SEMI_EXTERN_PHI: name = "LCP_SEMI_EXTERN_PHI"; break;
+        case LCP_PHI:             name = "LCP_PHI"; break;
+        case LCP_PARALLEL_PHI:    name = "LCP_PARALLEL_PHI"; break;
+        case LCP_GO:              name = "LCP_GO"; break;
+        case LCP_BWT_BASED2:      name = "LCP_BWT_BASED2"; break;
+    }
+    return "LCP " + name + " (estimated " + mib(lcp_bytes) + ")";
+}
 
 }
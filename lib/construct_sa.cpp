@@ -21,4 +21,24 @@ void construct_sa_se(cache_config& config)
     register_cache_file(conf::KEY_SA, config);
 }
 
+void construct_sa_sais_int(cache_config& config)
+{
+    int_vector<> text;
+    load_from_file(text, cache_file_name(conf::KEY_TEXT_INT, config));
+    util::bit_compress(text);
+
+    if (text.size() <= 2) {
+        // If text is c$ or $ write suffix array [1, 0] or [0]
+        int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config), std::ios::out, 8, 2);
+        if (text.size() == 2) {
+            sa.push_back(1);
+        }
+        sa.push_back(0);
+    } else {
+        uint64_t sigma = *std::max_element(text.begin(), text.end())+1;
+        _construct_sa_se<int_vector<>>(text, cache_file_name(conf::KEY_SA, config), sigma, 0);
+    }
+    register_cache_file(conf::KEY_SA, config);
+}
+
 }
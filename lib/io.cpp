@@ -6,6 +6,22 @@
 namespace sdsl
 {
 
+std::string store_path(const std::string& file)
+{
+    if (!is_ram_file(file) and mmap_registry::the_registry().maps(file)) {
+        return file + ".store_tmp";
+    }
+    return file;
+}
+
+bool finish_store(const std::string& path, const std::string& file)
+{
+    if (path != file and sdsl::rename(path, file) != 0) {
+        std::cerr<<"ERROR: could not replace `"<<file<<"` by `"<<path<<"`"<<std::endl;
+        return false;
+    }
+    return true;
+}
 
 bool store_to_file(const char* v, const std::string& file)
 {
@@ -62,6 +78,85 @@ void read_member<std::string>(std::string& t, std::istream& in)
     t.swap(temp);
 }
 
+constexpr uint64_t aligned_format::magic;
+constexpr uint64_t aligned_format::version;
+constexpr uint64_t aligned_format::alignment;
+constexpr uint64_t aligned_format::header_size;
+
+void aligned_format::write_header(std::ostream& out, uint64_t toc_offset, uint64_t toc_entries)
+{
+    uint64_t header[header_size/sizeof(uint64_t)] = {magic, version, toc_offset, toc_entries};
+    out.write((const char*)header, header_size);
+}
+
+bool aligned_format::read_header(std::istream& in, uint64_t& toc_offset, uint64_t& toc_entries)
+{
+    uint64_t header[header_size/sizeof(uint64_t)] = {};
+    in.read((char*)header, header_size);
+    if (!in or header[0] != magic) {
+        return false;
+    }
+    if (header[1] != version) {
+        throw std::runtime_error("aligned_format: unsupported version "+util::to_string(header[1]));
+    }
+    toc_offset  = header[2];
+    toc_entries = header[3];
+    return true;
+}
+
+void aligned_format::write_toc(const std::vector<toc_entry>& toc, std::ostream& out)
+{
+    for (const auto& e : toc) {
+        write_member(e.path, out);
+        write_member(e.type, out);
+        write_member(e.offset, out);
+        write_member(e.payload, out);
+        write_member(e.size, out);
+        write_member(e.width, out);
+    }
+}
+
+bool aligned_format::read_toc(const std::string& file, std::vector<toc_entry>& toc)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    uint64_t toc_offset, toc_entries;
+    if (!in or !read_header(in, toc_offset, toc_entries)) {
+        return false;
+    }
+    in.seekg(toc_offset);
+    toc.resize(toc_entries);
+    std::set<std::string> paths;
+    for (auto& e : toc) {
+        read_member(e.path, in);
+        if (!paths.insert(e.path).second) {
+            return false;
+        }
+        read_member(e.type, in);
+        read_member(e.offset, in);
+        read_member(e.payload, in);
+        read_member(e.size, in);
+        read_member(e.width, in);
+    }
+    return (bool)in;
+}
+
+void aligned_format::record(const structure_tree_node* v, uint64_t offset, uint64_t payload,
+                            uint64_t size, uint8_t width)
+{
+    std::string path, type = v ? v->type : "";
+    for (; v != nullptr; v = v->parent) {
+        if (!v->name.empty()) {
+            path = path.empty() ? v->name : v->name + "/" + path;
+        }
+    }
+    auto& c = the_context();
+    if (path.empty() or c.paths.count(path) != 0) {
+        path += "#" + util::to_string(c.toc.size());
+    }
+    c.paths.insert(path);
+    c.toc.push_back({path, type, offset, payload, size, width});
+}
+
 uint64_t _parse_number(std::string::const_iterator& c, const std::string::const_iterator& end)
 {
     std::string::const_iterator s = c;
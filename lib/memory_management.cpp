@@ -2,6 +2,10 @@
 #include <algorithm>
 #include "sdsl/memory_management.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace std::chrono;
 
 namespace sdsl
@@ -645,4 +649,93 @@ hugepage_allocator::determine_available_hugepage_memory()
 }
 
 
+mmap_registry::region*
+mmap_registry::find(const void* ptr)
+{
+    for (auto& r : m_regions) {
+        if ((const uint8_t*)ptr >= r.base and (const uint8_t*)ptr < r.base + r.size) {
+            return &r;
+        }
+    }
+    return nullptr;
+}
+
+uint8_t*
+mmap_registry::map(const std::string& file, size_t& file_size)
+{
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return nullptr;
+    }
+    file_size = st.st_size;
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t map_size = ((file_size + page_size - 1) / page_size + 1) * page_size;
+    // reserve the address range incl. a trailing zero page, then place the file on top
+    void* base = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    if (file_size > 0) {
+        void* data = mmap(base, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if (data == MAP_FAILED) {
+            munmap(base, map_size);
+            close(fd);
+            return nullptr;
+        }
+    }
+    close(fd);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_regions.push_back({(uint8_t*)base, map_size, 1, (uint64_t)st.st_dev, (uint64_t)st.st_ino});
+    m_num_regions.store(m_regions.size());
+    return (uint8_t*)base;
+}
+
+bool
+mmap_registry::maps(const std::string& file)
+{
+    if (m_num_regions.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    struct stat st;
+    if (stat(file.c_str(), &st) == -1) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& r : m_regions) {
+        if (r.dev == (uint64_t)st.st_dev and r.ino == (uint64_t)st.st_ino) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+mmap_registry::acquire(const void* ptr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    region* r = find(ptr);
+    if (r != nullptr) {
+        ++r->refs;
+    }
+}
+
+void
+mmap_registry::release(const void* ptr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    region* r = find(ptr);
+    if (r != nullptr and --r->refs == 0) {
+        munmap(r->base, r->size);
+        *r = m_regions.back();
+        m_regions.pop_back();
+        m_num_regions.store(m_regions.size());
+    }
+}
+
 }
@@ -133,6 +133,31 @@ osfstream::seekp(off_type off, std::ios_base::seekdir way)
     return *this;
 }
 
+std::streampos
+osfstream::tellp()
+{
+    ios_base::iostate err = std::ios_base::iostate(ios_base::goodbit);
+    pos_type p = pos_type(off_type(-1));
+    try {
+        if (!this->fail()) {
+            if (is_ram_file(m_file)) {
+                p = ((ram_filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
+            } else {
+                p = ((std::filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
+            }
+            if (p == pos_type(off_type(-1))) {
+                err |= ios_base::failbit;
+                this->setstate(err);
+            }
+        }
+    } catch (...) {
+        if (err) {
+            this->setstate(err);
+        }
+    }
+    return p;
+}
+
 
 
 //  IMPLEMENTATION OF ISFSTREAM
@@ -47,6 +47,28 @@ int main(int argc, char* argv[])
                 bv[j] = 1-default_value;
             }
         }
+    } else if ("CRAFTED-CLUSTERED" == ID) {
+        // uniform, sparse, dense and periodic regions, so that hyb_vector
+        // and pef_vector use all their block encodings
+        std::mt19937_64 rng(7);
+        bv = bit_vector(300000, 0);
+        uint64_t i = 0;
+        while (i < bv.size()) {
+            uint64_t kind = rng() % 5;
+            uint64_t len = 1 + rng() % 3000;
+            uint64_t run = 1 + rng() % 32;
+            for (uint64_t j=i; j < std::min(i+len, bv.size()); ++j) {
+                switch (kind) {
+                    case 0: bv[j] = 0; break;
+                    case 1: bv[j] = 1; break;
+                    case 2: bv[j] = (rng() % 64) == 0; break;
+                    case 3: bv[j] = (rng() % 64) != 0; break;
+                    default: bv[j] = ((j / run) & 1);
+                }
+            }
+            i += len;
+        }
+        bv.resize(bv.size() - 77);  // partial last block
     } else if ("CRAFTED-MAT-SELECT") {
         // Matthias Petri's test
         srand(4711);
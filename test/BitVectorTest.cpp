@@ -22,6 +22,7 @@ bit_vector_il<128>,
 bit_vector_il<256>,
 bit_vector_il<512>,
 bit_vector_il<1024>,
+bit_vector_cl,
 rrr_vector<64>,
 rrr_vector<256>,
 rrr_vector<129>,
@@ -35,7 +36,12 @@ rrr_vector<127>,
 rrr_vector<128>,
 sd_vector<>,
 sd_vector<rrr_vector<63> >,
-hyb_vector<>
+hyb_vector<>,
+hyb_vector<4>,
+pef_vector<>,
+pef_vector<64>,
+pef_vector<512>,
+rle_vector<>
 > Implementations;
 
 
@@ -128,6 +134,114 @@ TEST(SD_VECTOR, IteratorConstructor)
     }
 }
 
+//! Checks successor, predecessor and the cursor of an sd_vector against a scan of bv
+template<class t_sd>
+void check_sd_successor(const bit_vector& bv)
+{
+    t_sd sd(bv);
+    uint64_t n = bv.size();
+    std::vector<uint64_t> succ(n+1, n), pred(n, n);
+    for (uint64_t j=n; j > 0; --j) {
+        succ[j-1] = bv[j-1] ? j-1 : succ[j];
+    }
+    for (uint64_t j=0; j < n; ++j) {
+        pred[j] = bv[j] ? j : (j > 0 ? pred[j-1] : n);
+    }
+    for (uint64_t j=0; j <= n; ++j) {
+        ASSERT_EQ(succ[j], sd.successor(j)) << "j=" << j;
+    }
+    for (uint64_t j=0; j < n; ++j) {
+        ASSERT_EQ(pred[j], sd.predecessor(j)) << "j=" << j;
+    }
+    typename t_sd::cursor c(sd);
+    for (uint64_t r=0; !c.end(); c.next(), ++r) {
+        ASSERT_EQ(r, c.rank());
+        ASSERT_EQ(succ[c.value()], c.value());
+    }
+    ASSERT_EQ(n, c.value());
+    std::mt19937_64 rng(11);
+    for (uint64_t step : {1ULL, 3ULL, 100ULL, 10000ULL, 1000000ULL}) {
+        typename t_sd::cursor d(sd, n/7);
+        for (uint64_t x=n/7; x <= n; x += 1 + rng() % step) {
+            d.next_geq(x);
+            ASSERT_EQ(succ[x], d.value()) << "x=" << x;
+        }
+    }
+}
+
+TEST(SD_VECTOR, Successor)
+{
+    bit_vector bv;
+    ASSERT_TRUE(load_from_file(bv, test_file));
+    check_sd_successor<sd_vector<>>(bv);
+    check_sd_successor<sd_vector<rrr_vector<63>>>(bv);
+}
+
+//! Checks successor and predecessor of a pef_vector against a scan of bv
+template<class t_pef>
+void check_pef_successor(const bit_vector& bv)
+{
+    t_pef pef(bv);
+    uint64_t n = bv.size();
+    uint64_t succ = n;
+    for (uint64_t j=n; j > 0; --j) {
+        ASSERT_EQ(succ, pef.successor(j)) << "j=" << j;
+        if (bv[j-1]) succ = j-1;
+    }
+    ASSERT_EQ(succ, pef.successor(0));
+    uint64_t pred = n;
+    for (uint64_t j=0; j < n; ++j) {
+        if (bv[j]) pred = j;
+        ASSERT_EQ(pred, pef.predecessor(j)) << "j=" << j;
+    }
+}
+
+TEST(PEF_VECTOR, Successor)
+{
+    bit_vector bv;
+    ASSERT_TRUE(load_from_file(bv, test_file));
+    check_pef_successor<pef_vector<>>(bv);
+    check_pef_successor<pef_vector<64>>(bv);
+    check_pef_successor<pef_vector<512>>(bv);
+}
+
+//! The internal supports of a rle_vector have to point to the moved runs
+TEST(RLE_VECTOR, Move)
+{
+    bit_vector bv;
+    ASSERT_TRUE(load_from_file(bv, test_file));
+    rle_vector<> tmp(bv);
+    rle_vector<> moved(std::move(tmp));
+    rle_vector<> assigned;
+    assigned = rle_vector<>(bv);
+    for (const rle_vector<>* rle : {&moved, &assigned}) {
+        rle_vector<>::rank_1_type rank1(rle);
+        rle_vector<>::select_1_type sel1(rle);
+        uint64_t ones = 0;
+        for (uint64_t j=0; j < bv.size(); ++j) {
+            ASSERT_EQ((bool)bv[j], (bool)(*rle)[j]) << "j=" << j;
+            ASSERT_EQ(ones, rank1(j)) << "j=" << j;
+            if (bv[j]) {
+                ASSERT_EQ(j, sel1.select(++ones)) << "ones=" << ones;
+            }
+        }
+    }
+}
+
+//! The size of a rle_vector depends on the number of runs, not on their lengths
+TEST(RLE_VECTOR, SpaceOfLongRuns)
+{
+    bit_vector bv(10000000, 0);
+    for (uint64_t i=0; i < 1000; ++i) {
+        for (uint64_t j=i*10000; j < i*10000+(i+1)*7; ++j) {
+            bv[j] = 1;
+        }
+    }
+    rle_vector<> rle(bv);
+    ASSERT_EQ(1000ULL, rle.runs());
+    ASSERT_GT(size_in_bytes(sd_vector<>(bv))/4, size_in_bytes(rle));
+}
+
 }// end namespace
 
 int main(int argc, char* argv[])
@@ -136,6 +136,64 @@ TEST_F(BitsTest, cnt)
     }
 }
 
+//! Compare the bulk popcount of all available kernels with the word-wise one
+TEST_F(BitsTest, cnt_words)
+{
+    uint32_t features = sdsl::bits::cpu_features;
+    std::vector<uint32_t> masks = {0, sdsl::bits::CPU_POPCNT,
+                                   sdsl::bits::CPU_POPCNT|sdsl::bits::CPU_AVX2, features
+                                  };
+    for (uint32_t mask : masks) {
+        sdsl::bits::cpu_features = features & mask;
+        for (uint64_t n=0; n < 300; ++n) {
+            for (uint64_t off=0; off < 4; ++off) {
+                uint64_t expected = 0;
+                for (uint64_t i=0; i < n; ++i) {
+                    expected += cnt_naive(this->m_data[off+i]);
+                }
+                ASSERT_EQ(expected, sdsl::bits::cnt(this->m_data.data()+off, n)) << "mask=" << mask;
+            }
+        }
+        uint64_t expected = 0;
+        for (uint64_t i=0; i < this->m_data.size(); ++i) {
+            expected += sdsl::bits::cnt(this->m_data[i]);
+        }
+        ASSERT_EQ(expected, sdsl::bits::cnt(this->m_data.data(), this->m_data.size()));
+    }
+    sdsl::bits::cpu_features = features;
+}
+
+//! Compare read_ints and write_ints with and without the AVX2 kernels with read_int and write_int
+TEST_F(BitsTest, read_and_write_ints)
+{
+    uint32_t features = sdsl::bits::cpu_features;
+    for (uint32_t mask : {0U, features}) {
+        sdsl::bits::cpu_features = features & mask;
+        for (uint8_t len=1; len <= 64; ++len) {
+            for (uint64_t idx : {0ULL, 64ULL, 7ULL, 64ULL*len-len, 1000ULL}) {
+                uint64_t n = 200;
+                std::vector<uint64_t> out(n);
+                sdsl::bits::read_ints(this->m_data.data(), idx, len, n, out.data());
+                for (uint64_t i=0; i < n; ++i) {
+                    uint64_t pos = idx + i*len;
+                    ASSERT_EQ(sdsl::bits::read_int(this->m_data.data()+(pos>>6), pos&0x3F, len), out[i])
+                            << "mask=" << mask << " len=" << (int)len << " idx=" << idx << " i=" << i;
+                }
+                std::vector<uint64_t> data(this->m_data.data(), this->m_data.data()+(idx+n*len)/64+2);
+                std::vector<uint64_t> expected(data);
+                for (uint64_t i=0; i < n; ++i) {
+                    out[i] = ~out[i];
+                    uint64_t pos = idx + i*len;
+                    sdsl::bits::write_int(expected.data()+(pos>>6), out[i], pos&0x3F, len);
+                }
+                sdsl::bits::write_ints(data.data(), idx, len, n, out.data());
+                ASSERT_TRUE(expected == data) << "mask=" << mask << " len=" << (int)len << " idx=" << idx;
+            }
+        }
+    }
+    sdsl::bits::cpu_features = features;
+}
+
 //! Test the parametrized constructor
 TEST_F(BitsTest, sel)
 {
@@ -153,6 +211,22 @@ TEST_F(BitsTest, sel)
     }
 }
 
+//! Test select with and without the BMI2 kernel
+TEST_F(BitsTest, sel_dispatch)
+{
+    uint32_t features = sdsl::bits::cpu_features;
+    for (uint32_t mask : {0U, (uint32_t)sdsl::bits::CPU_BMI2}) {
+        sdsl::bits::cpu_features = features & mask;
+        for (uint64_t i=0; i < 100000; ++i) {
+            uint64_t x = this->m_data[i];
+            for (uint32_t j=1; j <= sdsl::bits::cnt(x); ++j) {
+                ASSERT_EQ(sel_naive(x, j), sdsl::bits::sel(x, j)) << "mask=" << mask;
+            }
+        }
+    }
+    sdsl::bits::cpu_features = features;
+}
+
 TEST_F(BitsTest, hi)
 {
     for (uint64_t i=0; i<64; ++i) {
@@ -0,0 +1,211 @@
+#include "sdsl/suffix_arrays.hpp"
+#include "sdsl/suffix_trees.hpp"
+#include "sdsl/wavelet_trees.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace sdsl;
+using namespace std;
+
+typedef int_vector<>::size_type size_type;
+
+string test_file;
+string temp_dir;
+
+const uint64_t num_threads = 8;
+const size_type num_queries = 2000;
+
+//! Runs f(t) for t=0..num_threads-1 concurrently
+template<class t_func>
+void run_threads(t_func f)
+{
+    vector<thread> threads;
+    for (uint64_t t=0; t < num_threads; ++t) {
+        threads.emplace_back(f, t);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+template<class T>
+class ConcurrentCsaTest : public ::testing::Test { };
+
+template<class T>
+class ConcurrentWtTest : public ::testing::Test { };
+
+template<class T>
+class ConcurrentCstTest : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<
+csa_sada<>,
+         csa_sada<enc_vector<>, 4, 4>,
+         csa_wt<>,
+         csa_wt<wt_int<>, 8, 8>,
+         csa_wt<wm_int<>, 8, 8>
+         > CsaImplementations;
+
+typedef Types<
+wt_huff<>,
+        wt_int<>,
+        wm_int<>,
+        wt_blcd<>
+        > WtImplementations;
+
+typedef Types<
+cst_sada<>,
+         cst_sct3<>
+         > CstImplementations;
+
+TYPED_TEST_CASE(ConcurrentCsaTest, CsaImplementations);
+TYPED_TEST_CASE(ConcurrentWtTest, WtImplementations);
+TYPED_TEST_CASE(ConcurrentCstTest, CstImplementations);
+
+//! Answers of all threads which query the same CSA have to match the sequential answers
+TYPED_TEST(ConcurrentCsaTest, Queries)
+{
+    TypeParam csa;
+    cache_config config(true, temp_dir, util::basename(test_file));
+    construct(csa, test_file, config, 1);
+    if (csa.size() < 2) {
+        return;
+    }
+    mt19937_64 rng(17);
+    vector<size_type> idx(num_queries), sa(num_queries), isa(num_queries), psi(num_queries);
+    vector<size_type> lf(num_queries), occ(num_queries);
+    vector<typename TypeParam::string_type> pattern(num_queries);
+    for (size_type q=0; q < num_queries; ++q) {
+        size_type i = rng() % csa.size();
+        idx[q] = i;
+        sa[q]  = csa[i];
+        isa[q] = csa.isa[i];
+        psi[q] = csa.psi[i];
+        lf[q]  = csa.lf[i];
+        size_type len = 1 + rng() % 8;
+        if (sa[q] + len >= csa.size()) {
+            len = csa.size()-1-sa[q];
+        }
+        if (len > 0) {
+            pattern[q] = extract(csa, sa[q], sa[q]+len-1);
+        }
+        occ[q] = count(csa, pattern[q].begin(), pattern[q].end());
+    }
+    atomic<size_type> errors(0);
+    run_threads([&](uint64_t t) {
+        for (size_type k=0; k < num_queries; ++k) {
+            size_type q = (k + t*num_queries/num_threads) % num_queries;
+            size_type i = idx[q];
+            bool ok = csa[i] == sa[q] and csa.isa[i] == isa[q] and csa.psi[i] == psi[q]
+                      and csa.lf[i] == lf[q]
+                      and count(csa, pattern[q].begin(), pattern[q].end()) == occ[q];
+            if (!ok) {
+                ++errors;
+            }
+        }
+    });
+    ASSERT_EQ((size_type)0, errors.load());
+    util::delete_all_files(config.file_map);
+}
+
+//! Answers of all threads which query the same wavelet tree have to match the sequential answers
+TYPED_TEST(ConcurrentWtTest, Queries)
+{
+    TypeParam wt;
+    cache_config config(true, temp_dir, util::basename(test_file));
+    construct(wt, test_file, config, 1);
+    if (wt.size() == 0) {
+        return;
+    }
+    mt19937_64 rng(17);
+    vector<size_type> idx(num_queries), value(num_queries), rank(num_queries), select(num_queries);
+    for (size_type q=0; q < num_queries; ++q) {
+        size_type i = rng() % wt.size();
+        idx[q]    = i;
+        value[q]  = wt[i];
+        rank[q]   = wt.rank(i, value[q]);
+        select[q] = wt.select(rank[q]+1, value[q]);
+    }
+    atomic<size_type> errors(0);
+    run_threads([&](uint64_t t) {
+        for (size_type k=0; k < num_queries; ++k) {
+            size_type q = (k + t*num_queries/num_threads) % num_queries;
+            size_type i = idx[q];
+            auto rc = wt.inverse_select(i);
+            bool ok = wt[i] == value[q] and wt.rank(i, value[q]) == rank[q]
+                      and wt.select(rank[q]+1, value[q]) == select[q]
+                      and rc.first == rank[q] and rc.second == value[q];
+            if (!ok) {
+                ++errors;
+            }
+        }
+    });
+    ASSERT_EQ((size_type)0, errors.load());
+}
+
+//! Answers of all threads which query the same CST have to match the sequential answers
+TYPED_TEST(ConcurrentCstTest, Queries)
+{
+    typedef typename TypeParam::node_type node_type;
+    TypeParam cst;
+    cache_config config(true, temp_dir, util::basename(test_file));
+    construct(cst, test_file, config, 1);
+    if (cst.size() < 2) {
+        return;
+    }
+    mt19937_64 rng(17);
+    vector<node_type> leaf(num_queries), parent(num_queries), sibling(num_queries), lca(num_queries);
+    vector<size_type> depth(num_queries);
+    for (size_type q=0; q < num_queries; ++q) {
+        leaf[q]    = cst.select_leaf(1 + rng() % cst.size());
+        parent[q]  = cst.parent(leaf[q]);
+        sibling[q] = cst.sibling(leaf[q]);
+        depth[q]   = cst.depth(parent[q]);
+        lca[q]     = cst.lca(leaf[q], leaf[q > 0 ? q-1 : 0]);
+    }
+    atomic<size_type> errors(0);
+    run_threads([&](uint64_t t) {
+        for (size_type k=0; k < num_queries; ++k) {
+            size_type q = (k + t*num_queries/num_threads) % num_queries;
+            node_type p = cst.parent(leaf[q]);
+            bool ok = p == parent[q] and cst.sibling(leaf[q]) == sibling[q]
+                      and cst.depth(p) == depth[q]
+                      and cst.lca(leaf[q], leaf[q > 0 ? q-1 : 0]) == lca[q];
+            if (!ok) {
+                ++errors;
+            }
+        }
+    });
+    ASSERT_EQ((size_type)0, errors.load());
+    util::delete_all_files(config.file_map);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 3) {
+        // LCOV_EXCL_START
+        cout << "Usage: " << argv[0] << " test_file tmp_dir" << endl;
+        cout << " (1) Generates CSAs, WTs, and CSTs out of test_file." << endl;
+        cout << "     Temporary files are stored in tmp_dir." << endl;
+        cout << " (2) Queries each structure from several threads concurrently" << endl;
+        cout << "     and compares the answers to the sequential ones." << endl;
+        cout << "     Build with -fsanitize=thread (make concurrent-query-tsan-test)" << endl;
+        cout << "     to detect data races." << endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    test_file = argv[1];
+    temp_dir  = argv[2];
+    return RUN_ALL_TESTS();
+}
@@ -3,6 +3,9 @@
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
+#include <sstream>
+#include <set>
+#include <random>
 
 namespace
 {
@@ -30,6 +33,9 @@ csa_wt<>,
        csa_sada<enc_vector<coder::fibonacci>>,
        csa_sada<enc_vector<coder::elias_gamma>>,
        csa_wt<wt_huff<>, 8, 16, text_order_sa_sampling<>>,
+       csa_wt<wt_huff<bit_vector_cl>, 8, 16>,
+       csa_wt<wt_huff<pef_vector<>>, 8, 16, text_order_sa_sampling<pef_vector<>>>,
+       csa_wt<wt_huff<>,32,32,fuzzy_sa_sampling<pef_vector<>, pef_vector<>>, fuzzy_isa_sampling_support<>>,
        csa_wt<wt_huff<>,32,32,fuzzy_sa_sampling<>>,
        csa_wt<wt_huff<>,32,32,fuzzy_sa_sampling<bit_vector, bit_vector>, fuzzy_isa_sampling_support<>>,
        csa_wt<wt_huff<>,32,32,fuzzy_sa_sampling<>, fuzzy_isa_sampling_support<>>,
@@ -40,6 +46,9 @@ csa_wt<>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, succinct_byte_alphabet<bit_vector, rank_support_v<>, select_support_mcl<>>>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, succinct_byte_alphabet<>>,
+       csa_wt<wt_huff<>, 32, 32, sa_order_sa_sampling<>, isa_sampling<>, byte_alphabet, kmer_table<4>>,
+       csa_sada<enc_vector<>, 32, 32, sa_order_sa_sampling<>, isa_sampling<>, byte_alphabet, kmer_table<3>>,
+       csa_bitcompressed<byte_alphabet, kmer_table<2>>,
        csa_bitcompressed<>
        > Implementations;
 
@@ -83,6 +92,43 @@ TYPED_TEST(CsaByteTest, BackwardSearch)
     ASSERT_EQ(r_res, (size_type)(csa.size() - 1));
 }
 
+//! Test backward_search_batch
+TYPED_TEST(CsaByteTest, BackwardSearchBatch)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng;
+    // substrings of the text of different lengths, so the searches of a group
+    // finish at different steps, plus some patterns which do not occur and
+    // the empty pattern
+    vector<string> patterns = {""};
+    for (size_type k=0; k < 1000 and text.size() > 0; ++k) {
+        size_type end = rng() % text.size() + 1;
+        size_type len = rng() % std::min(end, (size_type)(k%2 ? 4 : 40)) + 1;
+        string pat(text.begin()+(end-len), text.begin()+end);
+        if (k%5 == 0) {
+            pat[rng()%len] = rng();
+        }
+        patterns.push_back(pat);
+        patterns.push_back(pat);
+    }
+    auto intervals = backward_search_batch(csa, patterns);
+    auto counts = count_batch(csa, patterns);
+    ASSERT_EQ(patterns.size(), intervals.size());
+    ASSERT_EQ(patterns.size(), counts.size());
+    for (size_type k=0; k < patterns.size(); ++k) {
+        size_type l_res, r_res;
+        size_type cnt = backward_search(csa, 0, csa.size()-1, patterns[k].begin(), patterns[k].end(), l_res, r_res);
+        ASSERT_EQ(cnt, counts[k]) << "k=" << k;
+        if (cnt > 0) {
+            ASSERT_EQ(l_res, intervals[k].first) << "k=" << k;
+            ASSERT_EQ(r_res, intervals[k].second) << "k=" << k;
+        }
+    }
+}
+
 //! Test forward_search
 TYPED_TEST(CsaByteTest, ForwardSearch)
 {
@@ -146,6 +192,36 @@ TYPED_TEST(CsaByteTest, SaAccess)
     }
 }
 
+//! Test locate_interval and locate into a buffer
+TYPED_TEST(CsaByteTest, LocateInterval)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    size_type n = csa.size();
+    for (uint64_t threads : {1, 3}) {
+        std::vector<uint64_t> out(n);
+        locate_interval(csa, 0, n-1, out.data(), threads);
+        for (size_type j=0; j<n; ++j) {
+            ASSERT_EQ(csa[j], out[j])<<" j="<<j<<" threads="<<threads;
+        }
+    }
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng;
+    for (size_type k=0; k < 100 and text.size() > 0; ++k) {
+        size_type begin = rng() % text.size();
+        size_type len = rng() % std::min(text.size()-begin, (size_type)4) + 1;
+        auto pat = text.begin()+begin;
+        auto occs = locate(csa, pat, pat+len);
+        std::vector<uint64_t> buf(occs.size()/2+1);
+        size_type cnt = locate(csa, pat, pat+len, buf.data(), buf.size(), 2);
+        ASSERT_EQ(occs.size(), cnt);
+        for (size_type j=0; j < std::min(cnt, buf.size()); ++j) {
+            ASSERT_EQ(occs[j], buf[j])<<" k="<<k<<" j="<<j;
+        }
+    }
+}
+
 //! Test inverse suffix access methods
 TYPED_TEST(CsaByteTest, IsaAccess)
 {
@@ -190,6 +266,40 @@ TYPED_TEST(CsaByteTest, TextAccess)
     }
 }
 
+//! Test the segment extract engine with and without a text sample
+TYPED_TEST(CsaByteTest, ExtractSegments)
+{
+    if (test_case_file_map.find(conf::KEY_TEXT) != test_case_file_map.end()) {
+        TypeParam csa;
+        ASSERT_TRUE(load_from_file(csa, temp_file));
+        int_vector<8> text;
+        load_from_file(text, test_case_file_map[conf::KEY_TEXT]);
+        size_type n = text.size();
+        std::vector<std::pair<size_type, size_type>> hot = {{n/3, n/2}, {n-1, n-1}};
+        text_sample ts(csa, hot, 64);
+        text_sample empty_ts;
+        std::mt19937_64 rng;
+        for (size_type k=0; k < 50; ++k) {
+            size_type begin = rng() % n;
+            size_type end = k < 5 ? n-1 : begin + rng() % std::min(n-begin, (size_type)5000);
+            if (k == 0) begin = 0;
+            for (uint64_t threads : {1, 3}) {
+                std::string res(end-begin+1, 0);
+                ASSERT_EQ(end-begin+1, extract(csa, begin, end, res.begin(), threads));
+                for (size_type j=begin; j <= end; ++j) {
+                    ASSERT_EQ(text[j], (uint8_t)res[j-begin])<<" j="<<j<<" threads="<<threads;
+                }
+                std::string res_ts(end-begin+1, 0);
+                ASSERT_EQ(end-begin+1, extract(csa, begin, end, res_ts.begin(), ts, threads));
+                ASSERT_EQ(res, res_ts);
+                std::string res_empty(end-begin+1, 0);
+                extract(csa, begin, end, res_empty.begin(), empty_ts, threads);
+                ASSERT_EQ(res, res_empty);
+            }
+        }
+    }
+}
+
 //! Test Burrows-Wheeler access methods
 TYPED_TEST(CsaByteTest, BwtAccess)
 {
@@ -268,6 +378,182 @@ TYPED_TEST(CsaByteTest, SwapTest)
     }
 }
 
+//! Test loading via a mapping of the serialized file
+TYPED_TEST(CsaByteTest, MappedLoad)
+{
+    TypeParam csa1;
+    ASSERT_TRUE(load_from_file(csa1, temp_file));
+    std::stringstream ss1;
+    csa1.serialize(ss1);
+    {
+        // files in the default format are mapped where the payloads are 8-byte aligned
+        TypeParam csa2;
+        ASSERT_TRUE(load_from_file_mapped(csa2, temp_file));
+        std::stringstream ss2;
+        csa2.serialize(ss2);
+        ASSERT_EQ(ss1.str(), ss2.str());
+    }
+    std::string mapped_file = temp_file + "_mapped";
+    ASSERT_TRUE(store_to_file_aligned(csa1, mapped_file));
+    if (is_ram_file(mapped_file)) {
+        sdsl::remove(mapped_file);
+        return;
+    }
+    uint64_t mapped_before = memory_manager::mapped_bytes();
+    {
+        // in the aligned format all payloads are mapped, none is copied to the heap
+        TypeParam csa2;
+        memory_monitor::start();
+        ASSERT_TRUE(load_from_file_mapped(csa2, mapped_file));
+        memory_monitor::stop();
+        ASSERT_EQ((int64_t)0, memory_monitor::peak());
+        ASSERT_LT(mapped_before, memory_manager::mapped_bytes());
+        ASSERT_EQ(csa1.size(), csa2.size());
+        for (size_type j=0; j<csa1.size(); ++j) {
+            ASSERT_EQ(csa1[j], csa2[j]);
+            ASSERT_EQ(csa1.bwt[j], csa2.bwt[j]);
+        }
+        // storing over the mapped file must not invalidate csa2
+        ASSERT_TRUE(store_to_file_aligned(csa2, mapped_file));
+        std::stringstream ss2;
+        csa2.serialize(ss2);
+        ASSERT_EQ(ss1.str(), ss2.str());
+        TypeParam csa3;
+        ASSERT_TRUE(load_from_file_mapped(csa3, mapped_file));
+        std::stringstream ss3;
+        csa3.serialize(ss3);
+        ASSERT_EQ(ss1.str(), ss3.str());
+    }
+    ASSERT_EQ(mapped_before, memory_manager::mapped_bytes());
+    sdsl::remove(mapped_file);
+}
+
+//! Test storing in and loading from the aligned format
+TYPED_TEST(CsaByteTest, AlignedFormat)
+{
+    TypeParam csa1;
+    ASSERT_TRUE(load_from_file(csa1, temp_file));
+    std::string aligned_file = temp_file + "_aligned";
+    ASSERT_TRUE(store_to_file_aligned(csa1, aligned_file));
+    if (is_ram_file(aligned_file)) {
+        sdsl::remove(aligned_file);
+        return;
+    }
+    std::vector<aligned_format::toc_entry> toc;
+    ASSERT_TRUE(aligned_format::read_toc(aligned_file, toc));
+    ASSERT_LT((size_t)0, toc.size());
+    std::set<std::string> paths;
+    std::ifstream raw(aligned_file, std::ios::binary);
+    for (const auto& e : toc) {
+        ASSERT_FALSE(e.path.empty());
+        ASSERT_TRUE(paths.insert(e.path).second) << "duplicate path " << e.path;
+        ASSERT_EQ((uint64_t)0, e.payload % aligned_format::alignment);
+        if (e.type == util::class_name(bit_vector())) {
+            // lazy access to a single component
+            bit_vector bv;
+            ASSERT_TRUE(load_member_from_file(bv, aligned_file, e.path));
+            ASSERT_EQ(e.size, bv.size());
+            std::vector<char> bytes(((bv.size()+63)>>6)<<3);
+            raw.seekg(e.payload);
+            raw.read(bytes.data(), bytes.size());
+            ASSERT_EQ(0, memcmp(bytes.data(), bv.data(), bytes.size()));
+        }
+    }
+    for (bool mapped : {false, true}) {
+        TypeParam csa2;
+        if (mapped) {
+            ASSERT_TRUE(load_from_file_mapped(csa2, aligned_file));
+        } else {
+            ASSERT_TRUE(load_from_file(csa2, aligned_file));
+        }
+        std::stringstream ss1, ss2;
+        csa1.serialize(ss1);
+        csa2.serialize(ss2);
+        ASSERT_EQ(ss1.str(), ss2.str());
+    }
+    {
+        // a table of contents which lists a path twice is rejected
+        std::ofstream out(aligned_file, std::ios::binary | std::ios::trunc);
+        aligned_format::write_header(out, aligned_format::header_size, 2);
+        aligned_format::write_toc({toc[0], toc[0]}, out);
+    }
+    ASSERT_FALSE(aligned_format::read_toc(aligned_file, toc));
+    bit_vector bv;
+    ASSERT_FALSE(load_member_from_file(bv, aligned_file, toc[0].path));
+    sdsl::remove(aligned_file);
+}
+
+
+//! Test construction without a suffix array
+TYPED_TEST(CsaByteTest, SaFreeConstruction)
+{
+    TypeParam csa1;
+    ASSERT_TRUE(load_from_file(csa1, temp_file));
+    TypeParam csa2;
+    {
+        construct_config_guard guard;
+        construct_config::bwt_algo = BWT_SA_FREE;
+        cache_config config(true, temp_dir, util::basename(test_file)+"_sa_free");
+        construct(csa2, test_file, config, 1);
+    }
+    std::stringstream ss1, ss2;
+    csa1.serialize(ss1);
+    csa2.serialize(ss2);
+    ASSERT_EQ(ss1.str(), ss2.str());
+}
+
+//! Test construction with overlapping stages
+TYPED_TEST(CsaByteTest, PipelinedConstruction)
+{
+    TypeParam csa1;
+    ASSERT_TRUE(load_from_file(csa1, temp_file));
+    TypeParam csa2;
+    cache_config config(true, temp_dir, util::basename(test_file)+"_pipeline");
+    {
+        construct_config_guard guard;
+        construct_config::pipeline = true;
+        construct_config::num_threads = 2;
+        construct(csa2, test_file, config, 1);
+    }
+    std::stringstream ss1, ss2;
+    csa1.serialize(ss1);
+    csa2.serialize(ss2);
+    ASSERT_EQ(ss1.str(), ss2.str());
+    std::set<std::string> stages;
+    for (auto& st : config.stage_times) {
+        ASSERT_LE(0.0, st.second);
+        stages.insert(st.first);
+    }
+    ASSERT_EQ((size_t)1, stages.count("SA"));
+    ASSERT_EQ((size_t)1, stages.count("BWT"));
+    ASSERT_EQ((size_t)1, stages.count("construct CSA"));
+}
+
+//! Test construction with a memory budget
+TYPED_TEST(CsaByteTest, PlannedConstruction)
+{
+    TypeParam csa1;
+    ASSERT_TRUE(load_from_file(csa1, temp_file));
+    TypeParam csa2;
+    cache_config config(true, temp_dir, util::basename(test_file)+"_planned");
+    config.ram_budget = 1ULL<<40;
+    construct(csa2, test_file, config, 1);
+    std::stringstream ss1, ss2;
+    csa1.serialize(ss1);
+    csa2.serialize(ss2);
+    ASSERT_EQ(ss1.str(), ss2.str());
+    std::set<std::string> stages;
+    for (auto& st : config.stage_times) {
+        stages.insert(st.first);
+    }
+    // The planner skips the SA, if only the samples are needed
+    bool sa_free = TypeParam::sa_sample_dens > 1
+                   and sa_samples_trait<typename TypeParam::sa_sample_type>::value
+                   and sa_samples_trait<typename TypeParam::isa_sample_type>::value;
+    ASSERT_EQ((size_t)sa_free, stages.count("BWT (SA free)"));
+    ASSERT_EQ((size_t)sa_free, stages.count("SA samples"));
+    ASSERT_EQ((size_t)!sa_free, stages.count("SA"));
+}
 
 TYPED_TEST(CsaByteTest, DeleteTest)
 {
@@ -275,6 +561,36 @@ TYPED_TEST(CsaByteTest, DeleteTest)
     util::delete_all_files(test_case_file_map);
 }
 
+template<class T>
+class CsaByteMergeTest : public ::testing::Test { };
+
+typedef Types<
+csa_wt<>,
+       csa_sada<>,
+       csa_wt<wt_huff<>, 16, 16, text_order_sa_sampling<>, text_order_isa_sampling_support<>>
+       > MergeImplementations;
+
+TYPED_TEST_CASE(CsaByteMergeTest, MergeImplementations);
+
+//! Test merging the CSAs of the two halves of the text
+TYPED_TEST(CsaByteMergeTest, Merge)
+{
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::string first(text.begin(), text.begin()+text.size()/2);
+    std::string second(text.begin()+text.size()/2, text.end());
+    TypeParam csa_full, csa1, csa2, csa_merged;
+    construct_im(csa_full, (first+second).c_str(), 1);
+    construct_im(csa1, first.c_str(), 1);
+    construct_im(csa2, second.c_str(), 1);
+    cache_config config(true, temp_dir, util::basename(test_file)+"_merge");
+    construct_merge(csa_merged, csa1, csa2, config);
+    std::stringstream ss1, ss2;
+    csa_full.serialize(ss1);
+    csa_merged.serialize(ss2);
+    ASSERT_EQ(ss1.str(), ss2.str());
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
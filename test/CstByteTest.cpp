@@ -31,6 +31,7 @@ typedef Types<
 cst_sct3<>,
          cst_sada<>,
          cst_sct3<cst_sct3<>::csa_type, lcp_bitcompressed<>>,
+         cst_sct3<csa_wt<wt_huff<bit_vector_cl>>>,
          cst_sct3<cst_sct3<>::csa_type, lcp_support_tree2<>>,
          cst_sada<cst_sada<>::csa_type, lcp_dac<>>,
          cst_sada<cst_sada<>::csa_type, lcp_vlc<>>,
@@ -276,6 +277,26 @@ TYPED_TEST(CstByteTest, MoveSelectChild)
 
 
 
+//! The proxy returned by children() must not refer to the node it was created from
+TYPED_TEST(CstByteTest, ChildrenOfTemporaryNode)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    if (cst.degree(cst.root()) == 0) {
+        return;
+    }
+    auto children = cst.children(cst.select_child(cst.root(), cst.degree(cst.root())));
+    auto v = cst.select_child(cst.root(), cst.degree(cst.root()));
+    size_type i=1;
+    for (auto w : children) {
+        ASSERT_TRUE(i <= cst.degree(v));
+        ASSERT_EQ(cst.select_child(v, i), w) << i << "!";
+        ASSERT_EQ(w, children[i-1]);
+        ++i;
+    }
+    ASSERT_EQ(cst.degree(v)+1, i);
+}
+
 TYPED_TEST(CstByteTest, SelectLeafAndSn)
 {
     TypeParam cst;
@@ -368,6 +368,52 @@ TEST_F(IntVectorBufferTest, RandomAccess)
 }
 
 
+template<class t_T>
+void test_range_access(size_type exp_w)
+{
+    std::mt19937_64 rng(13);
+    std::string file_name = "tmp/int_vector_buffer";
+    size_type buffersize = 1024, n = 100000;
+    std::vector<uint64_t> buf(n);
+    for (size_type i=0; i < n; ++i) {
+        buf[i] = rng() & sdsl::bits::lo_set[exp_w];
+    }
+    t_T ivb(file_name, std::ios::out, buffersize, exp_w);
+    ivb.set_range(0, n/2, buf.data());
+    for (size_type i=n/2; i < n; ++i) {
+        ivb[i] = buf[i];
+    }
+    ASSERT_EQ(n, ivb.size());
+    for (size_type k=0; k < 50; ++k) {
+        size_type b = rng() % n, e = b + rng() % (n-b+1);
+        std::vector<uint64_t> out(e-b);
+        ivb.get_range(b, e, out.data());
+        for (size_type i=b; i < e; ++i) {
+            ASSERT_EQ(buf[i], out[i-b]) << "width=" << exp_w << " i=" << i;
+        }
+        for (size_type i=b; i < e; ++i) {
+            buf[i] = rng() & sdsl::bits::lo_set[exp_w];
+        }
+        ivb.set_range(b, e, buf.data()+b);
+    }
+    for (size_type i=0; i < n; ++i) {
+        ASSERT_EQ(buf[i], (size_type)ivb[i]);
+    }
+    ivb.close(true);
+}
+
+//! Test get_range and set_range
+TEST_F(IntVectorBufferTest, RangeAccess)
+{
+    for (size_type width=1; width <= 64; ++width) {
+        test_range_access< sdsl::int_vector_buffer<> >(width);
+    }
+    test_range_access< sdsl::int_vector_buffer<1> >(1);
+    test_range_access< sdsl::int_vector_buffer<8> >(8);
+    test_range_access< sdsl::int_vector_buffer<32> >(32);
+    test_range_access< sdsl::int_vector_buffer<64> >(64);
+}
+
 template<class t_T, class t_V>
 void test_file_handling(size_type exp_w)
 {
@@ -239,6 +239,66 @@ TEST_F(IntVectorTest, AssignAndModifyElement)
     test_AssignAndModifyElement<sdsl::int_vector<64> >(100000, 64);
 }
 
+template<class t_iv>
+void test_GetAndSetRange(size_type size, uint8_t width)
+{
+    std::mt19937_64 rng(width);
+    t_iv iv(size, 0, width);
+    for (size_type j=0; j < iv.size(); ++j) {
+        iv[j] = rng();
+    }
+    std::vector<uint64_t> buf(size);
+    for (size_type k=0; k < 20; ++k) {
+        size_type b = rng() % (size+1), e = b + rng() % (size-b+1);
+        iv.get_range(b, e, buf.data());
+        for (size_type j=b; j < e; ++j) {
+            ASSERT_EQ((uint64_t)iv[j], buf[j-b]) << "width=" << (int)width << " j=" << j;
+        }
+        t_iv expected = iv;
+        for (size_type j=b; j < e; ++j) {
+            buf[j-b] = rng() & sdsl::bits::lo_set[width];
+            expected[j] = buf[j-b];
+        }
+        iv.set_range(b, e, buf.data());
+        ASSERT_TRUE(expected == iv) << "width=" << (int)width << " b=" << b << " e=" << e;
+    }
+}
+
+TEST_F(IntVectorTest, GetAndSetRange)
+{
+    for (uint8_t width=1; width <= 64; ++width) {
+        test_GetAndSetRange< sdsl::int_vector<> >(10000, width);
+        test_GetAndSetRange< sdsl::int_vector<> >(65, width);
+    }
+    test_GetAndSetRange<sdsl::bit_vector     >(10000,  1);
+    test_GetAndSetRange<sdsl::int_vector< 8> >(10000,  8);
+    test_GetAndSetRange<sdsl::int_vector<16> >(10000, 16);
+    test_GetAndSetRange<sdsl::int_vector<32> >(10000, 32);
+    test_GetAndSetRange<sdsl::int_vector<64> >(10000, 64);
+}
+
+//! bit_compress and expand_width change the width in place
+TEST_F(IntVectorTest, CompressAndExpandWidth)
+{
+    std::mt19937_64 rng;
+    for (uint8_t width=1; width <= 64; ++width) {
+        sdsl::int_vector<> iv(5000, 0, 64);
+        for (size_type j=0; j < iv.size(); ++j) {
+            iv[j] = rng() & sdsl::bits::lo_set[width];
+        }
+        iv[rng() % iv.size()] = sdsl::bits::lo_set[width];
+        sdsl::int_vector<> expected = iv;
+        sdsl::util::bit_compress(iv);
+        ASSERT_EQ(width, iv.width());
+        for (size_type j=0; j < iv.size(); ++j) {
+            ASSERT_EQ((uint64_t)expected[j], (uint64_t)iv[j]);
+        }
+        sdsl::util::expand_width(iv, 64);
+        ASSERT_EQ(64, iv.width());
+        ASSERT_TRUE(expected == iv);
+    }
+}
+
 TEST_F(IntVectorTest, STL)
 {
     for (size_type i=0; i < vec_sizes.size(); ++i) {
@@ -306,6 +366,56 @@ TEST_F(IntVectorTest, SerializeFixedToVariable)
     sdsl::remove(file_name);
 }
 
+TEST_F(IntVectorTest, MappedLoad)
+{
+    std::mt19937_64 rng(13);
+    sdsl::int_vector<64> iv(100000);
+    for (size_type i=0; i<iv.size(); ++i)
+        iv[i] = rng();
+    std::string file_name = "tmp/int_vector_mapped";
+    sdsl::store_to_file(iv, file_name);
+    {
+        sdsl::int_vector<64> iv2;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(iv2, file_name));
+        ASSERT_TRUE(sdsl::memory_manager::is_mapped(iv2.data()));
+        ASSERT_EQ(iv, iv2);
+        // modifications are private to the process
+        iv2[0] = iv[0]+1;
+        sdsl::int_vector<64> iv3;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(iv3, file_name));
+        ASSERT_EQ(iv[0], iv3[0]);
+        // resizing copies the view to the heap
+        iv3.resize(iv.size()+1);
+        ASSERT_FALSE(sdsl::memory_manager::is_mapped(iv3.data()));
+        for (size_type i=0; i<iv.size(); ++i)
+            ASSERT_EQ(iv[i], iv3[i]);
+        ASSERT_EQ(0ULL, iv3[iv.size()]);
+    }
+    {
+        // global load mode
+        sdsl::memory_manager::use_mmap_load();
+        sdsl::int_vector<64> iv2;
+        ASSERT_TRUE(sdsl::load_from_file(iv2, file_name));
+        sdsl::memory_manager::use_mmap_load(false);
+        ASSERT_TRUE(sdsl::memory_manager::is_mapped(iv2.data()));
+        ASSERT_EQ(iv, iv2);
+    }
+    // unaligned payloads are copied
+    sdsl::int_vector<> iv4(1000, 5, 11);
+    sdsl::store_to_file(iv4, file_name);
+    sdsl::int_vector<> iv5;
+    ASSERT_TRUE(sdsl::load_from_file_mapped(iv5, file_name));
+    ASSERT_FALSE(sdsl::memory_manager::is_mapped(iv5.data()));
+    ASSERT_EQ(iv4, iv5);
+    // unless stored in aligned format
+    sdsl::store_to_file_aligned(iv4, file_name);
+    ASSERT_TRUE(sdsl::load_from_file_mapped(iv5, file_name));
+    ASSERT_TRUE(sdsl::memory_manager::is_mapped(iv5.data()));
+    ASSERT_EQ((uint64_t)0, (uint64_t)iv5.data() % sdsl::aligned_format::alignment);
+    ASSERT_EQ(iv4, iv5);
+    sdsl::remove(file_name);
+}
+
 TEST_F(IntVectorTest, IteratorTest)
 {
     for (auto i : vec_sizes) {
@@ -27,6 +27,7 @@ using testing::Types;
 typedef Types<
 k2_treap<2, bit_vector>,
          k2_treap<2, rrr_vector<63>>,
+         k2_treap<2, pef_vector<>>,
          k2_treap<3, bit_vector>,
          k2_treap<4, rrr_vector<63>>,
          k2_treap<5, rrr_vector<63>>,
@@ -1,10 +1,13 @@
 #include <sdsl/suffix_arrays.hpp>
+#include <sdsl/suffix_trees.hpp>
 #include <sdsl/construct_lcp.hpp>
 #include <sdsl/construct_bwt.hpp>
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
+#include <sstream>
 
 using namespace sdsl;
 using namespace std;
@@ -30,6 +33,7 @@ class LcpConstructTest : public ::testing::Test
             lcp_function["bwt_based"] = &construct_lcp_bwt_based;
             lcp_function["bwt_based2"] = &construct_lcp_bwt_based2;
             lcp_function["PHI"] = &construct_lcp_PHI<8>;
+            lcp_function["PHI_parallel"] = &construct_lcp_PHI_parallel<8>;
             lcp_function["semi_extern_PHI"] = &construct_lcp_semi_extern_PHI;
             lcp_function["go"] = &construct_lcp_go;
             lcp_function["goPHI"] = &construct_lcp_goPHI;
@@ -95,6 +99,61 @@ TEST_F(LcpConstructTest, construct_lcp)
     }
 }
 
+// Checks the LCP array of a CST built by construct() with the given settings
+void check_cst_lcp(const string& lcp_check_file, const string& id, uint64_t ram_budget, const string& info)
+{
+    cst_sct3<> cst;
+    cache_config config(true, temp_dir, id);
+    config.ram_budget = ram_budget;
+    construct(cst, test_file, config, 1);
+    int_vector<> lcp_check;
+    ASSERT_TRUE(load_from_file(lcp_check, lcp_check_file));
+    ASSERT_EQ(lcp_check.size(), cst.lcp.size()) << info;
+    for (uint64_t j=0; j<lcp_check.size(); ++j) {
+        ASSERT_EQ(lcp_check[j], cst.lcp[j]) << info << " lcp[" << j << "] differs";
+    }
+}
+
+TEST_F(LcpConstructTest, construct_dispatch)
+{
+    string lcp_check_file = cache_file_name(CHECK_KEY, this->test_config);
+    for (lcp_algo_type algo : {LCP_SEMI_EXTERN_PHI, LCP_PHI, LCP_PARALLEL_PHI, LCP_GO, LCP_BWT_BASED2}) {
+        construct_config_guard guard;
+        construct_config::lcp_algo = algo;
+        construct_plan plan;
+        plan.lcp_algo = algo;
+        check_cst_lcp(lcp_check_file, test_id+"_dispatch", 0, plan.lcp_info());
+    }
+}
+
+TEST_F(LcpConstructTest, construct_planned)
+{
+    int_vector<8> text;
+    ASSERT_TRUE(load_from_cache(text, conf::KEY_TEXT, this->test_config));
+    uint64_t n = text.size();
+    string lcp_check_file = cache_file_name(CHECK_KEY, this->test_config);
+    // Sweep the budget and construct the CST once for each LCP algorithm which is selected
+    std::set<lcp_algo_type> selected;
+    uint64_t step = std::max(n/16, (uint64_t)1);
+    for (uint64_t budget=step; budget <= 16*n + 16000000; budget += step) {
+        construct_plan plan = plan_construction(n, 8, 8, budget, construct_config::num_threads);
+        if (selected.count(plan.lcp_algo)) {
+            continue;
+        }
+        selected.insert(plan.lcp_algo);
+        memory_monitor::start();
+        check_cst_lcp(lcp_check_file, test_id+"_planned", budget, plan.lcp_info());
+        memory_monitor::stop();
+        std::stringstream log;
+        memory_monitor::write_memory_log<JSON_FORMAT>(log);
+        ASSERT_NE(string::npos, log.str().find(plan.lcp_info())) << plan.lcp_info() << " was not planned";
+    }
+    if (n >= 1024) {
+        ASSERT_TRUE(selected.count(LCP_GO));
+        ASSERT_TRUE(selected.count(LCP_SEMI_EXTERN_PHI));
+    }
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
@@ -113,5 +172,6 @@ int main(int argc, char** argv)
     test_file = argv[1];
     temp_dir  = argv[2];
     test_id   = argv[3];
+    construct_config::num_threads = 4;
     return RUN_ALL_TESTS();
 }
@@ -1,6 +1,7 @@
 #include "sdsl/bit_vectors.hpp"
 #include "sdsl/rank_support.hpp"
 #include "gtest/gtest.h"
+#include <random>
 #include <string>
 
 using namespace sdsl;
@@ -19,6 +20,7 @@ using testing::Types;
 typedef Types<rank_support_il<1, 256>,
         rank_support_il<1, 512>,
         rank_support_il<1, 1024>,
+        rank_support_cl<1>,
         rank_support_rrr<>,
         rank_support_v<>,
         rank_support_v5<>,
@@ -37,6 +39,7 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_il<0, 256>,
         rank_support_il<0, 512>,
         rank_support_il<0, 1024>,
+        rank_support_cl<0>,
         rank_support_rrr<0>,
         rank_support_v<0>,
         rank_support_v5<0>,
@@ -54,6 +57,13 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_sd<0>,
         rank_support_hyb<1>,
         rank_support_hyb<0>,
+        rank_support_hyb<1, 4>,
+        rank_support_pef<1>,
+        rank_support_pef<0>,
+        rank_support_pef<1, 64>,
+        rank_support_pef<0, 512>,
+        rank_support_rle<1>,
+        rank_support_rle<0>,
         rank_support_v<10,2>,
         rank_support_v<01,2>,
         rank_support_v<00,2>,
@@ -86,6 +96,24 @@ TYPED_TEST(RankSupportTest, RankMethod)
     EXPECT_EQ(rank, rs.rank(bvec.size()));
 }
 
+//! Test the batched rank method
+TYPED_TEST(RankSupportTest, BatchRankMethod)
+{
+    bit_vector bvec;
+    ASSERT_TRUE(load_from_file(bvec, test_file));
+    typename TypeParam::bit_vector_type bv(bvec);
+    TypeParam rs(&bv);
+    std::mt19937_64 rng(13);
+    vector<uint64_t> pos(1000), res(pos.size());
+    for (auto& p : pos) {
+        p = rng() % (bvec.size()+1);
+    }
+    rs.rank(pos.data(), pos.size(), res.data());
+    for (size_t j=0; j < pos.size(); ++j) {
+        ASSERT_EQ(rs.rank(pos[j]), res[j]);
+    }
+}
+
 }// end namespace
 
 int main(int argc, char** argv)
@@ -44,7 +44,7 @@ TEST_F(SaConstructTest, divsufsort)
 
 TEST_F(SaConstructTest, sesais)
 {
-    // Construct SA with seSAIS
+    // Construct SA with SAIS
     memory_monitor::start();
     construct_config::byte_algo_sa = SE_SAIS;
     construct_sa<8>(config);
@@ -52,22 +52,123 @@ TEST_F(SaConstructTest, sesais)
     cout << "# constructs_space = " << (1.0*memory_monitor::peak())/n << " byte per byte, =>" << memory_monitor::peak() << " bytes in total" << endl;
 }
 
+TEST_F(SaConstructTest, parallel)
+{
+    // Keep SA of seSAIS for comparison
+    sdsl::rename(cache_file_name(conf::KEY_SA, config), cache_file_name("check_sa_se", config));
+    config.file_map.erase(conf::KEY_SA);
+    register_cache_file("check_sa_se", config);
+    // Construct SA with parallel prefix doubling
+    memory_monitor::start();
+    construct_config::byte_algo_sa = PARALLEL_DOUBLING;
+    construct_config::num_threads  = 4;
+    construct_sa<8>(config);
+    memory_monitor::stop();
+    cout << "# constructs_space = " << (1.0*memory_monitor::peak())/n << " byte per byte, =>" << memory_monitor::peak() << " bytes in total" << endl;
+}
+
 TEST_F(SaConstructTest, compare)
 {
-    // Load both SAs
+    // Load all SAs
     int_vector_buffer<> sa_check(cache_file_name("check_sa", config));
+    int_vector_buffer<> sa_se(cache_file_name("check_sa_se", config));
     int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
 
     // Verify
+    ASSERT_EQ(sa_check.size(), sa_se.size()) << " suffix array size differ";
     ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ";
     for (uint64_t i=0; i<sa_check.size(); ++i) {
-        ASSERT_EQ(sa_check[i], sa[i]) << " sa differs at position " << i;
+        ASSERT_EQ(sa_check[i], sa_se[i]) << " sa of seSAIS differs at position " << i;
+        ASSERT_EQ(sa_check[i], sa[i]) << " sa of parallel doubling differs at position " << i;
+    }
+
+}
+
+TEST_F(SaConstructTest, qsufsort_int)
+{
+    // Construct SA over integer alphabet with qsufsort
+    construct_config::int_algo_sa = QSUFSORT;
+    construct_sa<0>(config);
+    sdsl::rename(cache_file_name(conf::KEY_SA, config), cache_file_name("check_sa_int", config));
+    config.file_map.erase(conf::KEY_SA);
+    register_cache_file("check_sa_int", config);
+}
+
+TEST_F(SaConstructTest, sais_int)
+{
+    // Construct SA over integer alphabet with SAIS
+    construct_config::int_algo_sa = SAIS_INT;
+    construct_sa<0>(config);
+    sdsl::rename(cache_file_name(conf::KEY_SA, config), cache_file_name("check_sa_sais_int", config));
+    config.file_map.erase(conf::KEY_SA);
+    register_cache_file("check_sa_sais_int", config);
+}
+
+TEST_F(SaConstructTest, parallel_int)
+{
+    // Construct SA over integer alphabet with parallel prefix doubling
+    construct_config::int_algo_sa = PARALLEL_DOUBLING_INT;
+    construct_config::num_threads = 4;
+    construct_sa<0>(config);
+}
+
+TEST_F(SaConstructTest, compare_int)
+{
+    int_vector_buffer<> sa_check(cache_file_name("check_sa_int", config));
+    int_vector_buffer<> sa_sais(cache_file_name("check_sa_sais_int", config));
+    int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
+
+    ASSERT_EQ(sa_check.size(), sa_sais.size()) << " suffix array size differ";
+    ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ";
+    for (uint64_t i=0; i<sa_check.size(); ++i) {
+        ASSERT_EQ(sa_check[i], sa_sais[i]) << " sa of SAIS differs at position " << i;
+        ASSERT_EQ(sa_check[i], sa[i]) << " sa of parallel doubling differs at position " << i;
     }
 
     // Remove all files
     util::delete_all_files(config.file_map);
 }
 
+TEST_F(SaConstructTest, plan)
+{
+    uint64_t m = 1ULL<<30;
+    // Enough memory: fastest algorithms
+    construct_plan plan = plan_construction(m, 8, 8, 100*m, 1);
+    ASSERT_EQ(LIBDIVSUFSORT, plan.byte_algo_sa);
+    ASSERT_EQ(LCP_PHI, plan.lcp_algo);
+    ASSERT_TRUE(plan.fits());
+    // Tight budget: space efficient algorithms
+    plan = plan_construction(m, 8, 8, 3*m, 1);
+    ASSERT_EQ(SE_SAIS, plan.byte_algo_sa);
+    ASSERT_EQ(LCP_GO, plan.lcp_algo);
+    ASSERT_TRUE(plan.fits());
+    plan = plan_construction(m, 8, 8, 3*m/2, 1);
+    ASSERT_EQ(LCP_SEMI_EXTERN_PHI, plan.lcp_algo);
+    ASSERT_LE(plan.lcp_bytes, plan.ram_budget);
+    // Large text: n*log(n)/64 exceeds n/2, so the BWT based algorithm is smaller
+    plan = plan_construction(1ULL<<40, 8, 8, (1ULL<<40)/10*16, 1);
+    ASSERT_EQ(LCP_BWT_BASED2, plan.lcp_algo);
+    ASSERT_LE(plan.lcp_bytes, plan.ram_budget);
+    // ISA samples: taken by LF walks, if the SA is not needed
+    plan = plan_construction(m, 8, 8, 100*m, 1, 32, true);
+    ASSERT_EQ(BWT_SA_FREE, plan.bwt_algo);
+    ASSERT_EQ(0ULL, plan.sa_bytes);
+    ASSERT_LT(0ULL, plan.isa_bytes);
+    ASSERT_TRUE(plan.fits());
+    plan = plan_construction(m, 8, 8, 100*m, 1, 32, false);
+    ASSERT_EQ(BWT_FROM_SA, plan.bwt_algo);
+    ASSERT_LT(0ULL, plan.isa_bytes);
+    // Too small budget: most space efficient algorithms
+    plan = plan_construction(m, 8, 8, m, 1);
+    ASSERT_EQ(SE_SAIS, plan.byte_algo_sa);
+    ASSERT_EQ(LCP_SEMI_EXTERN_PHI, plan.lcp_algo);
+    ASSERT_FALSE(plan.fits());
+    // Many threads: parallel algorithms
+    plan = plan_construction(m, 0, 20, 100*m, 64);
+    ASSERT_EQ(PARALLEL_DOUBLING_INT, plan.int_algo_sa);
+    ASSERT_EQ(LCP_PARALLEL_PHI, plan.lcp_algo);
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
@@ -93,10 +194,18 @@ int main(int argc, char** argv)
         if (contains_no_zero_symbol(text, test_file)) {
             append_zero_symbol(text);
             store_to_cache(text, conf::KEY_TEXT, config);
+            // Use the same text as integer sequence
+            int_vector<> text_int(text.size());
+            for (uint64_t i=0; i<text.size(); ++i) {
+                text_int[i] = text[i];
+            }
+            util::bit_compress(text_int);
+            store_to_cache(text_int, conf::KEY_TEXT_INT, config);
         }
         n = text.size();
     }
     register_cache_file(conf::KEY_TEXT, config);
+    register_cache_file(conf::KEY_TEXT_INT, config);
 
     return RUN_ALL_TESTS();
 }
@@ -1,6 +1,7 @@
 #include "sdsl/bit_vectors.hpp"
 #include "sdsl/select_support.hpp"
 #include "gtest/gtest.h"
+#include <random>
 #include <string>
 
 using namespace sdsl;
@@ -32,6 +33,12 @@ typedef Types<select_support_mcl<>,
         select_support_il<1, 256>,
         select_support_il<1, 512>,
         select_support_il<1, 1024>,
+        select_support_cl<1>,
+        select_support_hyb<1>,
+        select_support_hyb<1, 4>,
+        select_support_pef<1>,
+        select_support_pef<1, 64>,
+        select_support_rle<1>,
         select_support_mcl<0>,
         select_support_rrr<0, 256>,
         select_support_rrr<0>,
@@ -42,6 +49,12 @@ typedef Types<select_support_mcl<>,
         select_support_il<0, 256>,
         select_support_il<0, 512>,
         select_support_il<0, 1024>,
+        select_support_cl<0>,
+        select_support_hyb<0>,
+        select_support_hyb<0, 4>,
+        select_support_pef<0>,
+        select_support_pef<0, 512>,
+        select_support_rle<0>,
         select_support_mcl<01,2>,
         select_support_mcl<10,2>,
         select_support_mcl<00,2>,
@@ -74,6 +87,35 @@ TYPED_TEST(SelectSupportTest, SelectMethod)
     }
 }
 
+//! Test the batched select method
+TYPED_TEST(SelectSupportTest, BatchSelectMethod)
+{
+    bit_vector bvec;
+    ASSERT_TRUE(load_from_file(bvec, test_file));
+    typename TypeParam::bit_vector_type bv(bvec);
+    TypeParam ss(&bv);
+    uint64_t occ = 0;
+    for (uint64_t j=0; j < bvec.size(); ++j) {
+        bool found = (j >= TypeParam::bit_pat_len-1);
+        for (uint8_t k=0; found and k < TypeParam::bit_pat_len; ++k) {
+            found &= bvec[j-k] == ((TypeParam::bit_pat>>k)&1);
+        }
+        occ += found;
+    }
+    if (occ == 0) {
+        return;
+    }
+    std::mt19937_64 rng(13);
+    vector<uint64_t> args(1000), res(args.size());
+    for (auto& a : args) {
+        a = 1 + rng() % occ;
+    }
+    ss.select(args.data(), args.size(), res.data());
+    for (size_t j=0; j < args.size(); ++j) {
+        ASSERT_EQ(ss.select(args[j]), res[j]);
+    }
+}
+
 }// end namespace
 
 int main(int argc, char** argv)
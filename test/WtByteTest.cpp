@@ -2,6 +2,7 @@
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
+#include <sstream>
 #include <algorithm> // for std::min
 #include <random>
 
@@ -28,11 +29,16 @@ wt_pc<balanced_shape>
                       ,wt_blcd<bit_vector_il<>>
                       ,wt_blcd<bit_vector>
                       ,wt_huff<bit_vector_il<>>
+                      ,wt_huff<bit_vector_cl>
+                      ,wt_huff<hyb_vector<>>
+                      ,wt_huff<pef_vector<>>
+                      ,wt_huff<rle_vector<>>
                       ,wt_huff<bit_vector, rank_support_v<>>
                       ,wt_huff<bit_vector, rank_support_v5<>>
                       ,wt_huff<rrr_vector<63>>
                       ,wt_rlmn<>
                       ,wt_rlmn<bit_vector>
+                      ,wt_rlmn<rle_vector<>>
                       ,wt_gmr_rs<>
                       ,wt_hutu<bit_vector_il<>>
                       ,wt_hutu<bit_vector, rank_support_v<>>
@@ -143,6 +149,23 @@ TYPED_TEST(WtByteTest, Rank)
     }
 }
 
+//! Test the fused rank of two positions
+TYPED_TEST(WtByteTest, RankPair)
+{
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    std::mt19937_64 rng;
+    for (size_type k=0; k < 10000; ++k) {
+        size_type i = rng() % (wt.size()+1);
+        // mostly narrow intervals, as in backward search
+        size_type j = std::min((size_type)wt.size(), i + ((k&1) ? rng()%8 : rng()%(wt.size()+1)));
+        unsigned char c = (k%4 == 0 or wt.size() == 0) ? rng() : wt[rng()%wt.size()];
+        auto r = rank_pair(wt, i, j, c);
+        ASSERT_EQ(wt.rank(i, c), r.first) << "i="<<i<<" c="<<(size_type)c;
+        ASSERT_EQ(wt.rank(j, c), r.second) << "j="<<j<<" c="<<(size_type)c;
+    }
+}
+
 //! Test select methods
 TYPED_TEST(WtByteTest, Select)
 {
@@ -548,6 +571,39 @@ TYPED_TEST(WtByteTest, CreatePartiallyTest)
     compare_wt(text, wt);
 }
 
+//! Test that the multi-threaded construction yields the same wavelet tree
+TYPED_TEST(WtByteTest, ParallelConstruction)
+{
+    int_vector<8> iv;
+    ASSERT_TRUE(load_vector_from_file(iv, test_file, 1));
+    if (iv.empty()) {
+        return;
+    }
+    // repeat the text to get enough symbols for several threads
+    int_vector<8> text(std::max(iv.size(), 4*wt_parallel_min_chunk), 0, iv.width());
+    for (size_type i=0; i < text.size(); ++i) {
+        text[i] = iv[i % iv.size()];
+    }
+    string file = temp_file + "_text";
+    ASSERT_TRUE(store_to_plain_array<uint8_t>(text, file));
+    construct_config_guard guard;
+    string expected;
+    for (uint64_t threads : {1, 4}) {
+        construct_config::num_threads = threads;
+        TypeParam wt;
+        construct(wt, file, 1);
+        ASSERT_EQ(text.size(), wt.size());
+        stringstream ss;
+        wt.serialize(ss);
+        if (threads == 1) {
+            expected = ss.str();
+        } else {
+            ASSERT_EQ(expected, ss.str());
+        }
+    }
+    sdsl::remove(file);
+}
+
 TYPED_TEST(WtByteTest, DeleteTest)
 {
     sdsl::remove(temp_file);
@@ -2,9 +2,11 @@
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
+#include <sstream>
 #include <map>
 #include <queue>
 #include <algorithm>
+#include <random>
 
 namespace
 {
@@ -108,6 +110,25 @@ TYPED_TEST(WtIntTest, LoadAndRank)
     }
 }
 
+//! Test the fused rank of two positions
+TYPED_TEST(WtIntTest, LoadAndRankPair)
+{
+    int_vector<> iv;
+    load_from_file(iv, test_file);
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    std::mt19937_64 rng;
+    for (size_type k=0; k < 10000 and iv.size() > 0; ++k) {
+        size_type i = rng() % (wt.size()+1);
+        // mostly narrow intervals, as in backward search
+        size_type j = std::min((size_type)wt.size(), i + ((k&1) ? rng()%8 : rng()%(wt.size()+1)));
+        typename TypeParam::value_type c = (k%10 == 0) ? iv[rng()%iv.size()]+1 : iv[rng()%iv.size()];
+        auto r = rank_pair(wt, i, j, c);
+        ASSERT_EQ(wt.rank(i, c), r.first) << "i="<<i<<" c="<<c;
+        ASSERT_EQ(wt.rank(j, c), r.second) << "j="<<j<<" c="<<c;
+    }
+}
+
 //! Test the load method and rank method
 TYPED_TEST(WtIntTest, LoadAndMoveAndRank)
 {
@@ -832,6 +853,59 @@ TYPED_TEST(WtIntTest, restricted_unique_range_values)
 
 
 
+//! Test that the multi-threaded construction yields the same wavelet tree
+TYPED_TEST(WtIntTest, ParallelConstruction)
+{
+    int_vector<> iv;
+    ASSERT_TRUE(load_from_file(iv, test_file));
+    if (iv.empty()) {
+        return;
+    }
+    // repeat the text to get enough symbols for several threads
+    int_vector<> text(std::max(iv.size(), 4*wt_parallel_min_chunk), 0, iv.width());
+    for (size_type i=0; i < text.size(); ++i) {
+        text[i] = iv[i % iv.size()];
+    }
+    string file = temp_file + "_text";
+    ASSERT_TRUE(store_to_file(text, file));
+    construct_config_guard guard;
+    string expected;
+    for (uint64_t threads : {1, 4}) {
+        construct_config::num_threads = threads;
+        TypeParam wt;
+        sdsl::construct(wt, file);
+        ASSERT_EQ(text.size(), wt.size());
+        stringstream ss;
+        wt.serialize(ss);
+        if (threads == 1) {
+            expected = ss.str();
+        } else {
+            ASSERT_EQ(expected, ss.str());
+        }
+    }
+    sdsl::remove(file);
+}
+
+//! Test that the semi-external construction of wm_int yields the same wavelet matrix
+TEST(WmIntConstructTest, SemiExternal)
+{
+    construct_config_guard guard;
+    construct_config::num_threads = 1;
+    string expected;
+    for (bool semi_external : {false, true}) {
+        construct_config::wm_semi_external = semi_external;
+        wm_int<> wm;
+        sdsl::construct(wm, test_file);
+        stringstream ss;
+        wm.serialize(ss);
+        if (!semi_external) {
+            expected = ss.str();
+        } else {
+            ASSERT_EQ(expected, ss.str());
+        }
+    }
+}
+
 TYPED_TEST(WtIntTest, DeleteTest)
 {
     sdsl::remove(temp_file);